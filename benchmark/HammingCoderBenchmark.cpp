@@ -0,0 +1,478 @@
+/*
+ * HammingCoderBenchmark.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Throughput of Matrix::Multiply and of the Hamming coders.
+ *
+ * Every coder benchmark reports words/s and the data bytes per second. The
+ * error rate of the Correct benchmarks is 0%, 100% and the percentage in the
+ * HAMMING_BENCHMARK_ERROR_RATE environment variable (10% if unset). Run with
+ * --benchmark_format=json for machine-readable output.
+ */
+
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include "../src/BinaryHammingCoder.h"
+#include "../src/BitSlicedHammingCoder.h"
+#include "../src/FixedHammingCoder.h"
+#include "../src/HammingCodeFactory.h"
+#include "../src/HammingCoder.h"
+#include "../src/InterleavedHammingCoder.h"
+#include "../src/Matrix.h"
+#include "../src/MatrixArena.h"
+
+using namespace std;
+
+namespace {
+
+const int64_t kRedundancies[] = { 3, 4, 6 };
+const int64_t kBatchLengths[] = { 1, 64, 4096 };
+
+class Random {
+public:
+	explicit Random(uint64_t seed) :
+			state_(seed) {
+	}
+
+	uint64_t Next() {
+		state_ = state_ * 6364136223846793005ULL + 1442695040888963407ULL;
+		return state_ >> 11;
+	}
+
+private:
+	uint64_t state_;
+};
+
+int64_t GetErrorRate() {
+	const char *error_rate = getenv("HAMMING_BENCHMARK_ERROR_RATE");
+	return error_rate != NULL ? atoi(error_rate) : 10;
+}
+
+void CodeArguments(benchmark::internal::Benchmark *benchmark) {
+	benchmark->ArgNames( { "r", "words" });
+	for (size_t i = 0; i < sizeof(kRedundancies) / sizeof(kRedundancies[0]);
+			++i) {
+		for (size_t j = 0;
+				j < sizeof(kBatchLengths) / sizeof(kBatchLengths[0]); ++j) {
+			benchmark->Args( { kRedundancies[i], kBatchLengths[j] });
+		}
+	}
+}
+
+void CorrectArguments(benchmark::internal::Benchmark *benchmark) {
+	benchmark->ArgNames( { "r", "words", "error%" });
+	int64_t error_rates[] = { 0, GetErrorRate(), 100 };
+	for (size_t i = 0; i < sizeof(kRedundancies) / sizeof(kRedundancies[0]);
+			++i) {
+		for (size_t j = 0;
+				j < sizeof(kBatchLengths) / sizeof(kBatchLengths[0]); ++j) {
+			for (size_t k = 0; k < 3; ++k) {
+				benchmark->Args( { kRedundancies[i], kBatchLengths[j],
+						error_rates[k] });
+			}
+		}
+	}
+}
+
+void SetCounters(benchmark::State &state, size_t number_words,
+		size_t data_length) {
+	int64_t words = static_cast<int64_t>(state.iterations()) * number_words;
+	state.counters["words/s"] = benchmark::Counter(words,
+			benchmark::Counter::kIsRate);
+	state.SetBytesProcessed(words * data_length / 8);
+}
+
+struct Code {
+	explicit Code(size_t redundancy) {
+		hamming_code::HammingCodeFactory::CreateMatrices(2, redundancy,
+				&generator_matrix, &checker_matrix, &receiver_matrix);
+		coder = hamming_code::HammingCoder(2, generator_matrix, checker_matrix,
+				receiver_matrix);
+		word_length = generator_matrix.GetNumberRows();
+		data_length = generator_matrix.GetNumberColums();
+	}
+
+	void MakeData(size_t number_words, vector<hamming_code::Matrix::Value> *data) {
+		Random random(number_words);
+		data->resize(number_words * data_length);
+		for (size_t i = 0; i < data->size(); ++i) {
+			(*data)[i] = random.Next() & 1;
+		}
+	}
+
+	void MakeReceivedWords(size_t number_words, int64_t error_rate,
+			vector<hamming_code::Matrix::Value> *words) {
+		vector<hamming_code::Matrix::Value> data;
+		MakeData(number_words, &data);
+		words->resize(number_words * word_length);
+		coder.Encode(&data[0], number_words, &(*words)[0]);
+		Random random(number_words + 1);
+		for (size_t word_i = 0; word_i < number_words; ++word_i) {
+			if (static_cast<int64_t>(random.Next() % 100) < error_rate) {
+				(*words)[word_i * word_length + random.Next() % word_length] ^=
+						1;
+			}
+		}
+	}
+
+	hamming_code::Matrix generator_matrix;
+	hamming_code::Matrix checker_matrix;
+	hamming_code::Matrix receiver_matrix;
+	hamming_code::HammingCoder coder;
+	size_t word_length;
+	size_t data_length;
+};
+
+void PackWords(const vector<hamming_code::Matrix::Value> &values,
+		size_t word_length,
+		vector<hamming_code::BinaryHammingCoder::Word> *words) {
+	size_t number_words = values.size() / word_length;
+	words->assign(number_words, 0);
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		for (size_t i = 0; i < word_length; ++i) {
+			(*words)[word_i] |=
+					static_cast<hamming_code::BinaryHammingCoder::Word>(values[word_i
+							* word_length + i]) << i;
+		}
+	}
+}
+
+}
+
+static void BM_MatrixMultiply(benchmark::State &state) {
+	size_t number_rows = state.range(0);
+	size_t number_columns = state.range(1);
+	hamming_code::Matrix matrix0(number_rows, number_rows);
+	hamming_code::Matrix matrix1(number_rows, number_columns);
+	Random random(1);
+	for (size_t i = 0; i < number_rows * number_rows; ++i) {
+		matrix0.GetElements()[i] = random.Next() & 1;
+	}
+	for (size_t i = 0; i < number_rows * number_columns; ++i) {
+		matrix1.GetElements()[i] = random.Next() & 1;
+	}
+	hamming_code::Matrix ret;
+	while (state.KeepRunning()) {
+		hamming_code::Matrix::Multiply(matrix0, matrix1, &ret);
+		benchmark::DoNotOptimize(ret.GetElements());
+	}
+	state.counters["mul-add/s"] = benchmark::Counter(
+			static_cast<double>(state.iterations()) * number_rows * number_rows
+					* number_columns, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_MatrixMultiply)->ArgNames( { "n", "columns" })->Args( { 15, 1 })->Args(
+		{ 15, 4096 })->Args( { 63, 1 })->Args( { 63, 4096 })->Args(
+		{ 256, 256 });
+
+static void BM_BuildErrorTable(benchmark::State &state) {
+	Code code(state.range(0));
+	while (state.KeepRunning()) {
+		hamming_code::HammingCoder coder(2, code.generator_matrix,
+				code.checker_matrix, code.receiver_matrix);
+		benchmark::DoNotOptimize(&coder);
+	}
+}
+BENCHMARK(BM_BuildErrorTable)->ArgName("r")->Arg(3)->Arg(4)->Arg(6);
+
+static void BM_LoadCoder(benchmark::State &state) {
+	Code code(state.range(0));
+	string path = "hamming_code_benchmark_state";
+	code.coder.Save(path.c_str());
+	hamming_code::HammingCoder coder;
+	while (state.KeepRunning()) {
+		hamming_code::HammingCoder::Load(path.c_str(), &coder);
+		benchmark::DoNotOptimize(&coder);
+	}
+	remove(path.c_str());
+}
+BENCHMARK(BM_LoadCoder)->ArgName("r")->Arg(3)->Arg(4)->Arg(6);
+
+static void BM_HammingCoderEncodeMatrix(benchmark::State &state) {
+	Code code(state.range(0));
+	size_t number_words = state.range(1);
+	vector<hamming_code::Matrix::Value> data;
+	code.MakeData(number_words, &data);
+	hamming_code::Matrix data_matrix(code.data_length, number_words, &data[0]);
+	hamming_code::Matrix encoded_matrix;
+	while (state.KeepRunning()) {
+		code.coder.Encode(data_matrix, &encoded_matrix);
+		benchmark::DoNotOptimize(encoded_matrix.GetElements());
+	}
+	SetCounters(state, number_words, code.data_length);
+}
+BENCHMARK(BM_HammingCoderEncodeMatrix)->Apply(CodeArguments);
+
+static void BM_HammingCoderEncode(benchmark::State &state) {
+	Code code(state.range(0));
+	size_t number_words = state.range(1);
+	vector<hamming_code::Matrix::Value> data;
+	code.MakeData(number_words, &data);
+	vector<hamming_code::Matrix::Value> encoded_data(
+			number_words * code.word_length);
+	while (state.KeepRunning()) {
+		code.coder.Encode(&data[0], number_words, &encoded_data[0]);
+		benchmark::DoNotOptimize(&encoded_data[0]);
+	}
+	SetCounters(state, number_words, code.data_length);
+}
+BENCHMARK(BM_HammingCoderEncode)->Apply(CodeArguments);
+
+static void BM_HammingCoderTableEncode(benchmark::State &state) {
+	Code code(state.range(0));
+	code.coder.SetEngine(hamming_code::HammingCoder::kTableEngine);
+	size_t number_words = state.range(1);
+	vector<hamming_code::Matrix::Value> data;
+	code.MakeData(number_words, &data);
+	vector<hamming_code::Matrix::Value> encoded_data(
+			number_words * code.word_length);
+	while (state.KeepRunning()) {
+		code.coder.Encode(&data[0], number_words, &encoded_data[0]);
+		benchmark::DoNotOptimize(&encoded_data[0]);
+	}
+	SetCounters(state, number_words, code.data_length);
+}
+BENCHMARK(BM_HammingCoderTableEncode)->Apply(CodeArguments);
+
+static void BM_HammingCoderCorrectMatrix(benchmark::State &state) {
+	Code code(state.range(0));
+	size_t number_words = state.range(1);
+	vector<hamming_code::Matrix::Value> words;
+	code.MakeReceivedWords(number_words, state.range(2), &words);
+	hamming_code::Matrix received_matrix(number_words, code.word_length,
+			&words[0]);
+	hamming_code::Matrix word_matrix(code.word_length, number_words);
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		for (size_t i = 0; i < code.word_length; ++i) {
+			word_matrix.SetElement(i, word_i,
+					received_matrix.GetElement(word_i, i));
+		}
+	}
+	hamming_code::Matrix corrected_matrix;
+	while (state.KeepRunning()) {
+		code.coder.Correct(word_matrix, &corrected_matrix);
+		benchmark::DoNotOptimize(corrected_matrix.GetElements());
+	}
+	SetCounters(state, number_words, code.data_length);
+}
+BENCHMARK(BM_HammingCoderCorrectMatrix)->Apply(CorrectArguments);
+
+static void BM_HammingCoderCorrect(benchmark::State &state) {
+	Code code(state.range(0));
+	size_t number_words = state.range(1);
+	vector<hamming_code::Matrix::Value> words;
+	code.MakeReceivedWords(number_words, state.range(2), &words);
+	vector<hamming_code::Matrix::Value> corrected_data(words.size());
+	while (state.KeepRunning()) {
+		code.coder.Correct(&words[0], number_words, &corrected_data[0]);
+		benchmark::DoNotOptimize(&corrected_data[0]);
+	}
+	SetCounters(state, number_words, code.data_length);
+}
+BENCHMARK(BM_HammingCoderCorrect)->Apply(CorrectArguments);
+
+static void BM_HammingCoderTableCorrect(benchmark::State &state) {
+	Code code(state.range(0));
+	size_t number_words = state.range(1);
+	vector<hamming_code::Matrix::Value> words;
+	code.MakeReceivedWords(number_words, state.range(2), &words);
+	code.coder.SetEngine(hamming_code::HammingCoder::kTableEngine);
+	vector<hamming_code::Matrix::Value> corrected_data(words.size());
+	while (state.KeepRunning()) {
+		code.coder.Correct(&words[0], number_words, &corrected_data[0]);
+		benchmark::DoNotOptimize(&corrected_data[0]);
+	}
+	SetCounters(state, number_words, code.data_length);
+}
+BENCHMARK(BM_HammingCoderTableCorrect)->Apply(CorrectArguments);
+
+static void BM_HammingCoderVerifyMatrix(benchmark::State &state) {
+	Code code(state.range(0));
+	size_t number_words = state.range(1);
+	vector<hamming_code::Matrix::Value> words;
+	code.MakeReceivedWords(number_words, state.range(2), &words);
+	vector<hamming_code::Matrix::Value> word_values(words.size());
+	hamming_code::MatrixView word_view(code.word_length, number_words,
+			&word_values[0]);
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		for (size_t i = 0; i < code.word_length; ++i) {
+			word_view.SetElement(i, word_i, words[word_i * code.word_length + i]);
+		}
+	}
+	vector<size_t> dirty_words;
+	while (state.KeepRunning()) {
+		code.coder.Verify(word_view, &dirty_words);
+		benchmark::DoNotOptimize(dirty_words.size());
+	}
+	SetCounters(state, number_words, code.data_length);
+}
+BENCHMARK(BM_HammingCoderVerifyMatrix)->Apply(CorrectArguments);
+
+static void BM_HammingCoderVerify(benchmark::State &state) {
+	Code code(state.range(0));
+	size_t number_words = state.range(1);
+	vector<hamming_code::Matrix::Value> words;
+	code.MakeReceivedWords(number_words, state.range(2), &words);
+	vector<size_t> dirty_words;
+	while (state.KeepRunning()) {
+		code.coder.Verify(&words[0], number_words, &dirty_words);
+		benchmark::DoNotOptimize(dirty_words.size());
+	}
+	SetCounters(state, number_words, code.data_length);
+}
+BENCHMARK(BM_HammingCoderVerify)->Apply(CorrectArguments);
+
+static void BM_HammingCoderDecode(benchmark::State &state) {
+	Code code(state.range(0));
+	size_t number_words = state.range(1);
+	vector<hamming_code::Matrix::Value> words;
+	code.MakeReceivedWords(number_words, 0, &words);
+	vector<hamming_code::Matrix::Value> data(number_words * code.data_length);
+	while (state.KeepRunning()) {
+		code.coder.Decode(&words[0], number_words, &data[0]);
+		benchmark::DoNotOptimize(&data[0]);
+	}
+	SetCounters(state, number_words, code.data_length);
+}
+BENCHMARK(BM_HammingCoderDecode)->Apply(CodeArguments);
+
+static void BM_InterleavedHammingCoderCorrect(benchmark::State &state) {
+	Code code(state.range(0));
+	size_t depth = state.range(1);
+	size_t number_blocks = 4096 / depth;
+	size_t number_words = number_blocks * depth;
+	vector<hamming_code::Matrix::Value> words;
+	code.MakeReceivedWords(number_words, state.range(2), &words);
+	vector<hamming_code::Matrix::Value> blocks(words.size());
+	hamming_code::InterleavedHammingCoder::Interleave(&words[0],
+			code.word_length, depth, number_blocks, &blocks[0]);
+	hamming_code::InterleavedHammingCoder coder(&code.coder, depth);
+	vector<hamming_code::Matrix::Value> corrected_blocks(blocks.size());
+	hamming_code::MatrixArena arena;
+	while (state.KeepRunning()) {
+		corrected_blocks = blocks;
+		arena.Reset();
+		coder.Correct(&corrected_blocks[0], number_blocks, &arena);
+		benchmark::DoNotOptimize(&corrected_blocks[0]);
+	}
+	SetCounters(state, number_words, code.data_length);
+}
+BENCHMARK(BM_InterleavedHammingCoderCorrect)->ArgNames( { "r", "depth",
+		"error%" })->Args( { 4, 64, 10 })->Args( { 4, 512, 10 })->Args(
+		{ 6, 64, 10 })->Args( { 6, 512, 10 });
+
+static void BM_BinaryHammingCoderEncode(benchmark::State &state) {
+	Code code(state.range(0));
+	size_t number_words = state.range(1);
+	hamming_code::BinaryHammingCoder coder(code.generator_matrix,
+			code.checker_matrix, code.receiver_matrix);
+	vector<hamming_code::Matrix::Value> values;
+	code.MakeData(number_words, &values);
+	vector<hamming_code::BinaryHammingCoder::Word> data;
+	PackWords(values, code.data_length, &data);
+	vector<hamming_code::BinaryHammingCoder::Word> encoded_data(number_words);
+	while (state.KeepRunning()) {
+		coder.Encode(&data[0], number_words, &encoded_data[0]);
+		benchmark::DoNotOptimize(&encoded_data[0]);
+	}
+	SetCounters(state, number_words, code.data_length);
+}
+BENCHMARK(BM_BinaryHammingCoderEncode)->Apply(CodeArguments);
+
+static void BM_BinaryHammingCoderCorrect(benchmark::State &state) {
+	Code code(state.range(0));
+	size_t number_words = state.range(1);
+	hamming_code::BinaryHammingCoder coder(code.generator_matrix,
+			code.checker_matrix, code.receiver_matrix);
+	vector<hamming_code::Matrix::Value> values;
+	code.MakeReceivedWords(number_words, state.range(2), &values);
+	vector<hamming_code::BinaryHammingCoder::Word> words;
+	PackWords(values, code.word_length, &words);
+	vector<hamming_code::BinaryHammingCoder::Word> corrected_data(
+			number_words);
+	while (state.KeepRunning()) {
+		coder.Correct(&words[0], number_words, &corrected_data[0]);
+		benchmark::DoNotOptimize(&corrected_data[0]);
+	}
+	SetCounters(state, number_words, code.data_length);
+}
+BENCHMARK(BM_BinaryHammingCoderCorrect)->Apply(CorrectArguments);
+
+static void BM_BitSlicedHammingCoderEncode(benchmark::State &state) {
+	Code code(state.range(0));
+	size_t number_words = state.range(1);
+	hamming_code::BitSlicedHammingCoder coder(code.generator_matrix,
+			code.checker_matrix, code.receiver_matrix);
+	size_t number_blocks =
+			hamming_code::BitSlicedHammingCoder::GetNumberBlocks(number_words);
+	size_t slice_length = hamming_code::BitSlicedHammingCoder::kSliceLength;
+	vector<hamming_code::BitSlicedHammingCoder::Word> data(
+			number_blocks * code.data_length * slice_length, 0x5555);
+	vector<hamming_code::BitSlicedHammingCoder::Word> encoded_data(
+			number_blocks * code.word_length * slice_length);
+	while (state.KeepRunning()) {
+		coder.Encode(&data[0], number_blocks, &encoded_data[0]);
+		benchmark::DoNotOptimize(&encoded_data[0]);
+	}
+	// The padding words of the last block are not counted.
+	SetCounters(state, number_words, code.data_length);
+}
+BENCHMARK(BM_BitSlicedHammingCoderEncode)->Apply(CodeArguments);
+
+template<typename Coder>
+static void BM_FixedHammingCoderEncode(benchmark::State &state) {
+	size_t number_words = state.range(0);
+	Coder coder;
+	Random random(number_words);
+	vector<typename Coder::Word> data(number_words);
+	for (size_t i = 0; i < number_words; ++i) {
+		data[i] = random.Next() & ((static_cast<uint64_t>(1) << Coder::kDataLength) - 1);
+	}
+	vector<typename Coder::Word> encoded_data(number_words);
+	while (state.KeepRunning()) {
+		for (size_t i = 0; i < number_words; ++i) {
+			coder.Encode(data[i], &encoded_data[i]);
+		}
+		benchmark::DoNotOptimize(&encoded_data[0]);
+	}
+	SetCounters(state, number_words, Coder::kDataLength);
+}
+BENCHMARK_TEMPLATE(BM_FixedHammingCoderEncode, hamming_code::HammingCoder7_4)->ArgName("words")->Arg(4096);
+BENCHMARK_TEMPLATE(BM_FixedHammingCoderEncode, hamming_code::HammingCoder15_11)->ArgName("words")->Arg(4096);
+BENCHMARK_TEMPLATE(BM_FixedHammingCoderEncode, hamming_code::HammingCoder63_57)->ArgName("words")->Arg(4096);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,274 @@
+/*
+ * AsyncHammingCoder.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "AsyncHammingCoder.h"
+#include "Status.h"
+#include <unistd.h>
+#include <algorithm>
+
+namespace hamming_code {
+
+AsyncHammingCoder::Job::Job(Operation operation, const Matrix::Value *data,
+		size_t number_words, Matrix::Value *ret_data) :
+		operation_(operation), data_(data), number_words_(number_words), ret_data_(
+				ret_data), status_(kSuccess), done_(false) {
+}
+
+AsyncHammingCoder::Job::~Job() {
+
+}
+
+void AsyncHammingCoder::Job::Complete(int) {
+
+}
+
+AsyncHammingCoder::AsyncHammingCoder(const HammingCoder *coder,
+		size_t number_threads, size_t queue_length) :
+		coder_(coder), queue_(queue_length > 0 ? queue_length : 1), queue_begin_(
+				0), number_queued_jobs_(0), stop_(false) {
+	if (number_threads == 0) {
+		long number_processors = sysconf(_SC_NPROCESSORS_ONLN);
+		number_threads = number_processors > 0 ? number_processors : 1;
+	}
+	pthread_mutex_init(&mutex_, NULL);
+	pthread_cond_init(&job_cond_, NULL);
+	pthread_cond_init(&space_cond_, NULL);
+	pthread_cond_init(&done_cond_, NULL);
+	size_t word_length = coder_->GetWordLength();
+	for (size_t i = 0; i < number_threads; ++i) {
+		Worker *worker = new Worker;
+		worker->coder = this;
+		worker->data.resize(kBatchLength * word_length);
+		worker->ret_data.resize(kBatchLength * word_length);
+		workers_.push_back(worker);
+	}
+	for (size_t i = 0; i < number_threads; ++i) {
+		pthread_create(&workers_[i]->thread, NULL, RunWorker, workers_[i]);
+	}
+}
+
+AsyncHammingCoder::~AsyncHammingCoder() {
+	pthread_mutex_lock(&mutex_);
+	stop_ = true;
+	pthread_cond_broadcast(&job_cond_);
+	pthread_mutex_unlock(&mutex_);
+	for (size_t i = 0; i < workers_.size(); ++i) {
+		pthread_join(workers_[i]->thread, NULL);
+		delete workers_[i];
+	}
+	pthread_cond_destroy(&done_cond_);
+	pthread_cond_destroy(&space_cond_);
+	pthread_cond_destroy(&job_cond_);
+	pthread_mutex_destroy(&mutex_);
+}
+
+int AsyncHammingCoder::Submit(Job *job) {
+	return Push(job, true);
+}
+
+int AsyncHammingCoder::TrySubmit(Job *job) {
+	return Push(job, false);
+}
+
+int AsyncHammingCoder::Wait(Job *job) {
+	pthread_mutex_lock(&mutex_);
+	while (!job->done_) {
+		pthread_cond_wait(&done_cond_, &mutex_);
+	}
+	pthread_mutex_unlock(&mutex_);
+	return job->status_;
+}
+
+void *AsyncHammingCoder::RunWorker(void *arg) {
+	Worker *worker = static_cast<Worker *>(arg);
+	AsyncHammingCoder *coder = worker->coder;
+	while (coder->PopJobs(&worker->jobs)) {
+		coder->RunBatch(kEncode, worker);
+		coder->RunBatch(kCorrect, worker);
+		coder->RunBatch(kDecode, worker);
+		// Jobs are freed after Wait, so done_ is set after the callbacks.
+		for (size_t i = 0; i < worker->jobs.size(); ++i) {
+			Job *job = worker->jobs[i];
+			job->Complete(job->status_);
+		}
+		pthread_mutex_lock(&coder->mutex_);
+		for (size_t i = 0; i < worker->jobs.size(); ++i) {
+			worker->jobs[i]->done_ = true;
+		}
+		pthread_cond_broadcast(&coder->done_cond_);
+		pthread_mutex_unlock(&coder->mutex_);
+	}
+	return NULL;
+}
+
+int AsyncHammingCoder::Push(Job *job, bool wait) {
+	if (job->operation_ != kEncode && job->operation_ != kCorrect
+			&& job->operation_ != kDecode) {
+		return kInvalidArgument;
+	}
+	pthread_mutex_lock(&mutex_);
+	while (number_queued_jobs_ == queue_.size()) {
+		if (!wait) {
+			pthread_mutex_unlock(&mutex_);
+			return kQueueFull;
+		}
+		pthread_cond_wait(&space_cond_, &mutex_);
+	}
+	job->status_ = kSuccess;
+	job->done_ = false;
+	queue_[(queue_begin_ + number_queued_jobs_) % queue_.size()] = job;
+	++number_queued_jobs_;
+	pthread_cond_signal(&job_cond_);
+	pthread_mutex_unlock(&mutex_);
+	return kSuccess;
+}
+
+// Takes at least one job and then as many as fit in kBatchLength words.
+// Returns false once the coder stops and the queue is empty.
+bool AsyncHammingCoder::PopJobs(std::vector<Job *> *jobs) {
+	jobs->clear();
+	pthread_mutex_lock(&mutex_);
+	while (number_queued_jobs_ == 0 && !stop_) {
+		pthread_cond_wait(&job_cond_, &mutex_);
+	}
+	size_t number_words = 0;
+	while (number_queued_jobs_ > 0) {
+		Job *job = queue_[queue_begin_];
+		if (!jobs->empty()
+				&& (number_words + job->number_words_ > kBatchLength
+						|| jobs->size() == kBatchLength)) {
+			break;
+		}
+		jobs->push_back(job);
+		number_words += job->number_words_;
+		queue_begin_ = (queue_begin_ + 1) % queue_.size();
+		--number_queued_jobs_;
+	}
+	if (!jobs->empty()) {
+		pthread_cond_broadcast(&space_cond_);
+	}
+	pthread_mutex_unlock(&mutex_);
+	return !jobs->empty();
+}
+
+int AsyncHammingCoder::RunJob(const Job &job) const {
+	switch (job.operation_) {
+	case kEncode:
+		return coder_->Encode(job.data_, job.number_words_, job.ret_data_);
+	case kCorrect:
+		if (job.data_ == job.ret_data_) {
+			return coder_->Correct(job.ret_data_, job.number_words_);
+		}
+		return coder_->Correct(job.data_, job.number_words_, job.ret_data_);
+	case kDecode:
+		return coder_->Decode(job.data_, job.number_words_, job.ret_data_);
+	}
+	return kInvalidArgument;
+}
+
+// The jobs of one operation are gathered into the worker buffers, coded by
+// one call and scattered back. Correct jobs are coded one by one instead:
+// a batch correction could not tell which jobs hold uncorrectable words
+// without checking them again, which would count their words twice.
+int AsyncHammingCoder::RunBatch(Operation operation, Worker *worker) {
+	size_t number_jobs = 0;
+	size_t number_words = 0;
+	for (size_t i = 0; i < worker->jobs.size(); ++i) {
+		const Job *job = worker->jobs[i];
+		if (job->operation_ == operation) {
+			++number_jobs;
+			number_words += job->number_words_;
+		}
+	}
+	if (number_jobs == 0) {
+		return 0;
+	}
+	if (number_jobs == 1 || number_words > kBatchLength
+			|| operation == kCorrect) {
+		for (size_t i = 0; i < worker->jobs.size(); ++i) {
+			Job *job = worker->jobs[i];
+			if (job->operation_ == operation) {
+				job->status_ = RunJob(*job);
+			}
+		}
+		return 0;
+	}
+	size_t input_length = GetInputLength(operation);
+	size_t output_length = GetOutputLength(operation);
+	Matrix::Value *data = &worker->data[0];
+	Matrix::Value *ret_data = &worker->ret_data[0];
+	Matrix::Value *position = data;
+	for (size_t i = 0; i < worker->jobs.size(); ++i) {
+		const Job *job = worker->jobs[i];
+		if (job->operation_ == operation) {
+			position = std::copy(job->data_,
+					job->data_ + job->number_words_ * input_length, position);
+		}
+	}
+	int status = kSuccess;
+	switch (operation) {
+	case kEncode:
+		status = coder_->Encode(data, number_words, ret_data);
+		break;
+	case kDecode:
+		status = coder_->Decode(data, number_words, ret_data);
+		break;
+	default:
+		break;
+	}
+	position = ret_data;
+	for (size_t i = 0; i < worker->jobs.size(); ++i) {
+		Job *job = worker->jobs[i];
+		if (job->operation_ != operation) {
+			continue;
+		}
+		size_t length = job->number_words_ * output_length;
+		job->status_ = status;
+		std::copy(position, position + length, job->ret_data_);
+		position += length;
+	}
+	return 0;
+}
+
+size_t AsyncHammingCoder::GetInputLength(Operation operation) const {
+	return operation == kEncode ?
+			coder_->GetDataLength() : coder_->GetWordLength();
+}
+
+size_t AsyncHammingCoder::GetOutputLength(Operation operation) const {
+	return operation == kDecode ?
+			coder_->GetDataLength() : coder_->GetWordLength();
+}
+
+} /* namespace hamming_code */
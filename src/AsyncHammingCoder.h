@@ -0,0 +1,149 @@
+/*
+ * AsyncHammingCoder.h
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ASYNCHAMMINGCODER_H_
+#define ASYNCHAMMINGCODER_H_
+
+#include <stddef.h>
+#include <pthread.h>
+#include <vector>
+#include "HammingCoder.h"
+#include "Matrix.h"
+
+namespace hamming_code {
+
+/*
+ * Codes jobs on worker threads while the submitting threads go on.
+ *
+ * Jobs wait in one bounded queue shared by all producers and workers.
+ * Submit blocks while the queue is full, so producers cannot run ahead of
+ * the workers; TrySubmit returns kQueueFull instead. A worker takes as many
+ * queued jobs as fit in kBatchLength words and codes its encode and
+ * decode jobs with a single call each through its own buffers. Correct
+ * jobs get one call each, so every job has its own status and statistics
+ * count each word once. A finished job
+ * gets its Complete callback on the worker, after which Wait returns.
+ */
+class AsyncHammingCoder {
+public:
+	enum Operation {
+		kEncode, kCorrect, kDecode
+	};
+
+	static const size_t kDefaultQueueLength = 1024;
+	static const size_t kBatchLength = 4096;
+
+	// Words are laid out contiguously as for HammingCoder. A correct job may
+	// code in place, with data equal to ret_data. The buffers and the job
+	// must live until the job is done, that is until Wait returns; the
+	// worker still marks the job done after Complete returns.
+	class Job {
+	public:
+		Job(Operation operation, const Matrix::Value *data,
+				size_t number_words, Matrix::Value *ret_data);
+
+		virtual ~Job();
+
+		// Called by the worker once the job is coded. It must not free or
+		// resubmit the job.
+		virtual void Complete(int status);
+
+		int GetStatus() const {
+			return status_;
+		}
+
+	private:
+		friend class AsyncHammingCoder;
+
+		Operation operation_;
+		const Matrix::Value *data_;
+		size_t number_words_;
+		Matrix::Value *ret_data_;
+		int status_;
+		bool done_;
+	};
+
+	// Uses one thread per online processor when number_threads is 0. The
+	// coder must outlive this object.
+	AsyncHammingCoder(const HammingCoder *coder, size_t number_threads,
+			size_t queue_length = kDefaultQueueLength);
+
+	// Finishes the queued jobs, then stops the workers.
+	virtual ~AsyncHammingCoder();
+
+	int Submit(Job *job);
+	int TrySubmit(Job *job);
+	// Blocks until job is done and returns its status.
+	int Wait(Job *job);
+
+	size_t GetNumberThreads() const {
+		return workers_.size();
+	}
+
+private:
+	struct Worker {
+		AsyncHammingCoder *coder;
+		pthread_t thread;
+		std::vector<Job *> jobs;
+		std::vector<Matrix::Value> data;
+		std::vector<Matrix::Value> ret_data;
+	};
+
+	static void *RunWorker(void *arg);
+
+	AsyncHammingCoder(const AsyncHammingCoder &);
+	AsyncHammingCoder &operator=(const AsyncHammingCoder &);
+
+	int Push(Job *job, bool wait);
+	bool PopJobs(std::vector<Job *> *jobs);
+	int RunJob(const Job &job) const;
+	int RunBatch(Operation operation, Worker *worker);
+	size_t GetInputLength(Operation operation) const;
+	size_t GetOutputLength(Operation operation) const;
+
+	const HammingCoder *coder_;
+	pthread_mutex_t mutex_;
+	pthread_cond_t job_cond_;
+	pthread_cond_t space_cond_;
+	pthread_cond_t done_cond_;
+	// Ring buffer of number_queued_jobs_ jobs starting at queue_begin_.
+	std::vector<Job *> queue_;
+	size_t queue_begin_;
+	size_t number_queued_jobs_;
+	bool stop_;
+	std::vector<Worker *> workers_;
+};
+
+} /* namespace hamming_code */
+#endif /* ASYNCHAMMINGCODER_H_ */
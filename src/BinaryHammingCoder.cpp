@@ -0,0 +1,218 @@
+/*
+ * BinaryHammingCoder.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "BinaryHammingCoder.h"
+#include "Matrix.h"
+#include "Status.h"
+#include <stdint.h>
+#include <assert.h>
+
+namespace hamming_code {
+
+int BinaryHammingCoder::Pack(Matrix &matrix, Word *word) {
+	size_t length = matrix.GetNumberRows() * matrix.GetNumberColums();
+	if (length > kMaxWordLength) {
+		return 1;
+	}
+	Matrix::Value *values = matrix.GetElements();
+	Word ret = 0;
+	for (size_t i = 0; i < length; ++i) {
+		ret |= static_cast<Word>(values[i] & 1) << i;
+	}
+	*word = ret;
+	return 0;
+}
+
+int BinaryHammingCoder::Unpack(Word word, size_t length, Matrix *matrix) {
+	if (length > kMaxWordLength) {
+		return 1;
+	}
+	if (matrix->GetNumberRows() != length || matrix->GetNumberColums() != 1) {
+		*matrix = Matrix(length, 1);
+	}
+	Matrix::Value *values = matrix->GetElements();
+	for (size_t i = 0; i < length; ++i) {
+		values[i] = (word >> i) & 1;
+	}
+	return 0;
+}
+
+const size_t BinaryHammingCoder::kMaxWordLength;
+const size_t BinaryHammingCoder::kMaxSyndromeLength;
+
+BinaryHammingCoder::BinaryHammingCoder() :
+		data_mask_(0) {
+	Clear();
+}
+
+BinaryHammingCoder::BinaryHammingCoder(Matrix &generator_matrix,
+		Matrix &checker_matrix, Matrix &receiver_matrix) :
+		data_mask_(0) {
+	Init(generator_matrix, checker_matrix, receiver_matrix);
+}
+
+BinaryHammingCoder::~BinaryHammingCoder() {
+
+}
+
+int BinaryHammingCoder::Init(Matrix &generator_matrix, Matrix &checker_matrix,
+		Matrix &receiver_matrix) {
+	size_t word_length = generator_matrix.GetNumberRows();
+	size_t data_length = generator_matrix.GetNumberColums();
+	if (checker_matrix.GetNumberRows() > kMaxSyndromeLength
+			|| checker_matrix.GetNumberColums() != word_length
+			|| receiver_matrix.GetNumberRows() != data_length
+			|| receiver_matrix.GetNumberColums() != word_length
+			|| PackRows(generator_matrix, &generator_rows_) != kSuccess
+			|| PackRows(checker_matrix, &checker_rows_) != kSuccess
+			|| PackRows(receiver_matrix, &receiver_rows_) != kSuccess) {
+		Clear();
+		return kInvalidArgument;
+	}
+	BuildErrorTable();
+	data_mask_ = 0;
+	if (IsSystematic()) {
+		data_mask_ = ~static_cast<Word>(0)
+				>> (kMaxWordLength - receiver_rows_.size());
+	}
+	return kSuccess;
+}
+
+int BinaryHammingCoder::Encode(Word data, Word *encoded_data) {
+	*encoded_data = Multiply(generator_rows_, data);
+	return 0;
+}
+
+int BinaryHammingCoder::Correct(Word data, Word *corrected_data) {
+	Word syndrome = Multiply(checker_rows_, data);
+	Word error = error_table_[syndrome];
+	*corrected_data = data ^ error;
+	return syndrome != 0 && error == 0 ? kUncorrectableError : kSuccess;
+}
+
+int BinaryHammingCoder::Decode(Word encoded_data, Word *data) {
+	*data = data_mask_ ?
+			encoded_data & data_mask_ : Multiply(receiver_rows_, encoded_data);
+	return 0;
+}
+
+int BinaryHammingCoder::Encode(const Word *data, size_t number_words,
+		Word *encoded_data) {
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		encoded_data[word_i] = Multiply(generator_rows_, data[word_i]);
+	}
+	return 0;
+}
+
+int BinaryHammingCoder::Correct(const Word *data, size_t number_words,
+		Word *corrected_data) {
+	int ret = kSuccess;
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		Word syndrome = Multiply(checker_rows_, data[word_i]);
+		Word error = error_table_[syndrome];
+		corrected_data[word_i] = data[word_i] ^ error;
+		ret |= syndrome != 0 && error == 0 ? kUncorrectableError : kSuccess;
+	}
+	return ret;
+}
+
+int BinaryHammingCoder::Decode(const Word *encoded_data, size_t number_words,
+		Word *data) {
+	if (data_mask_) {
+		for (size_t word_i = 0; word_i < number_words; ++word_i) {
+			data[word_i] = encoded_data[word_i] & data_mask_;
+		}
+		return 0;
+	}
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		data[word_i] = Multiply(receiver_rows_, encoded_data[word_i]);
+	}
+	return 0;
+}
+
+int BinaryHammingCoder::PackRows(Matrix &matrix, std::vector<Word> *rows) {
+	size_t number_rows = matrix.GetNumberRows();
+	size_t number_columns = matrix.GetNumberColums();
+	if (number_rows > kMaxWordLength || number_columns > kMaxWordLength) {
+		return kInvalidArgument;
+	}
+	rows->assign(number_rows, 0);
+	Matrix::Value *values = matrix.GetElements();
+	for (size_t row_i = 0; row_i < number_rows; ++row_i) {
+		size_t offset = row_i * number_columns;
+		Word row = 0;
+		for (size_t column_i = 0; column_i < number_columns; ++column_i) {
+			row |= static_cast<Word>(values[offset + column_i] & 1) << column_i;
+		}
+		(*rows)[row_i] = row;
+	}
+	return 0;
+}
+
+// An empty coder has no symbols; its error table only maps syndrome 0.
+void BinaryHammingCoder::Clear() {
+	generator_rows_.clear();
+	checker_rows_.clear();
+	receiver_rows_.clear();
+	error_table_.assign(1, 0);
+	data_mask_ = 0;
+}
+
+int BinaryHammingCoder::BuildErrorTable() {
+	size_t syndrome_length = checker_rows_.size();
+	assert(syndrome_length <= kMaxSyndromeLength);
+	error_table_.assign(static_cast<size_t>(1) << syndrome_length, 0);
+	size_t word_length = generator_rows_.size();
+	for (size_t i = 0; i < word_length; ++i) {
+		Word error = static_cast<Word>(1) << i;
+		error_table_[Multiply(checker_rows_, error)] = error;
+	}
+	error_table_[0] = 0;
+	return 0;
+}
+
+bool BinaryHammingCoder::IsSystematic() const {
+	size_t data_length = receiver_rows_.size();
+	if (data_length == 0) {
+		return false;
+	}
+	for (size_t i = 0; i < data_length; ++i) {
+		if (receiver_rows_[i] != static_cast<Word>(1) << i) {
+			return false;
+		}
+	}
+	return true;
+}
+
+} /* namespace hamming_code */
@@ -0,0 +1,126 @@
+/*
+ * BinaryHammingCoder.h
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BINARYHAMMINGCODER_H_
+#define BINARYHAMMINGCODER_H_
+
+#include <stdint.h>
+#include <vector>
+#include "Matrix.h"
+
+namespace hamming_code {
+
+/*
+ * Hamming coder specialized for the binary alphabet.
+ *
+ * A word is packed into a single 64 bit integer: bit i holds the i-th symbol
+ * of the column vector used by HammingCoder. The generator, checker and
+ * receiver matrices are stored as one packed mask per row, so every output
+ * bit is the parity of (row & word). Correct returns kUncorrectableError if
+ * the syndrome matches no single error.
+ */
+class BinaryHammingCoder {
+public:
+	typedef uint64_t Word;
+
+	static const size_t kMaxWordLength = 64;
+	// The error table has 2^r entries.
+	static const size_t kMaxSyndromeLength = 16;
+
+	static int Pack(Matrix &matrix, Word *word);
+	static int Unpack(Word word, size_t length, Matrix *matrix);
+
+	BinaryHammingCoder();
+	// Leaves an empty coder if Init fails.
+	BinaryHammingCoder(Matrix &generator_matrix, Matrix &checker_matrix,
+			Matrix &receiver_matrix);
+
+	virtual ~BinaryHammingCoder();
+
+	// Returns kInvalidArgument and leaves an empty coder if a matrix has more
+	// than kMaxWordLength rows or columns, the checker matrix more than
+	// kMaxSyndromeLength rows or the shapes do not fit together.
+	int Init(Matrix &generator_matrix, Matrix &checker_matrix,
+			Matrix &receiver_matrix);
+
+	int Encode(Word data, Word *encoded_data);
+	int Correct(Word data, Word *corrected_data);
+	int Decode(Word encoded_data, Word *data);
+
+	int Encode(const Word *data, size_t number_words, Word *encoded_data);
+	int Correct(const Word *data, size_t number_words, Word *corrected_data);
+	int Decode(const Word *encoded_data, size_t number_words, Word *data);
+
+	size_t GetWordLength() const {
+		return generator_rows_.size();
+	}
+
+	size_t GetDataLength() const {
+		return receiver_rows_.size();
+	}
+
+	size_t GetSyndromeLength() const {
+		return checker_rows_.size();
+	}
+
+private:
+	static Word Parity(Word word) {
+		return __builtin_popcountll(word) & 1;
+	}
+
+	static int PackRows(Matrix &matrix, std::vector<Word> *rows);
+	static Word Multiply(const std::vector<Word> &rows, Word word) {
+		Word ret = 0;
+		size_t number_rows = rows.size();
+		for (size_t row_i = 0; row_i < number_rows; ++row_i) {
+			ret |= Parity(rows[row_i] & word) << row_i;
+		}
+		return ret;
+	}
+
+	void Clear();
+	int BuildErrorTable();
+	bool IsSystematic() const;
+
+	std::vector<Word> generator_rows_;
+	std::vector<Word> checker_rows_;
+	std::vector<Word> receiver_rows_;
+	std::vector<Word> error_table_;
+	// Set when the data symbols are the first symbols of a word, so decoding
+	// is a mask.
+	Word data_mask_;
+};
+
+} /* namespace hamming_code */
+#endif /* BINARYHAMMINGCODER_H_ */
@@ -0,0 +1,354 @@
+/*
+ * BitSlicedHammingCoder.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "BitSlicedHammingCoder.h"
+#include "Matrix.h"
+#include "Status.h"
+#include <algorithm>
+#include <stdint.h>
+#include <assert.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAMMING_CODE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace hamming_code {
+
+BitSlicedHammingCoder::InstructionSet BitSlicedHammingCoder::GetSupportedInstructionSet() {
+#ifdef HAMMING_CODE_X86_SIMD
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) {
+		return kAvx512;
+	} else if (__builtin_cpu_supports("avx2")) {
+		return kAvx2;
+	} else if (__builtin_cpu_supports("sse2")) {
+		return kSse2;
+	}
+#endif
+	return kScalar;
+}
+
+int BitSlicedHammingCoder::Slice(const Word *words, size_t number_words,
+		size_t word_length, Word *slices) {
+	size_t number_blocks = GetNumberBlocks(number_words);
+	size_t block_size = word_length * kSliceLength;
+	std::fill(slices, slices + number_blocks * block_size, 0);
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		Word *block = slices + (word_i / kBlockLength) * block_size;
+		size_t lane = word_i % kBlockLength;
+		size_t lane_offset = lane / (sizeof(Word) * 8);
+		size_t lane_shift = lane % (sizeof(Word) * 8);
+		Word word = words[word_i];
+		for (size_t i = 0; i < word_length; ++i) {
+			block[i * kSliceLength + lane_offset] |= ((word >> i) & 1)
+					<< lane_shift;
+		}
+	}
+	return 0;
+}
+
+int BitSlicedHammingCoder::Unslice(const Word *slices, size_t number_words,
+		size_t word_length, Word *words) {
+	size_t block_size = word_length * kSliceLength;
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		const Word *block = slices + (word_i / kBlockLength) * block_size;
+		size_t lane = word_i % kBlockLength;
+		size_t lane_offset = lane / (sizeof(Word) * 8);
+		size_t lane_shift = lane % (sizeof(Word) * 8);
+		Word word = 0;
+		for (size_t i = 0; i < word_length; ++i) {
+			word |= ((block[i * kSliceLength + lane_offset] >> lane_shift) & 1)
+					<< i;
+		}
+		words[word_i] = word;
+	}
+	return 0;
+}
+
+BitSlicedHammingCoder::BitSlicedHammingCoder() :
+		instruction_set_(kScalar), xor_kernel_(XorScalar) {
+
+}
+
+BitSlicedHammingCoder::BitSlicedHammingCoder(Matrix &generator_matrix,
+		Matrix &checker_matrix, Matrix &receiver_matrix) :
+		instruction_set_(GetSupportedInstructionSet()), xor_kernel_(
+				GetXorKernel(instruction_set_)) {
+	BuildRowIndices(generator_matrix, &generator_);
+	BuildRowIndices(checker_matrix, &checker_);
+	BuildRowIndices(receiver_matrix, &receiver_);
+	BuildErrorTable(checker_matrix);
+}
+
+BitSlicedHammingCoder::~BitSlicedHammingCoder() {
+
+}
+
+int BitSlicedHammingCoder::Encode(const Word *data, size_t number_blocks,
+		Word *encoded_data) {
+	xor_kernel_(generator_, data, number_blocks, encoded_data);
+	return 0;
+}
+
+int BitSlicedHammingCoder::CalculateSyndrome(const Word *data,
+		size_t number_blocks, Word *syndrome) {
+	xor_kernel_(checker_, data, number_blocks, syndrome);
+	return 0;
+}
+
+// The syndromes of one block at a time live on the stack, so a call
+// allocates nothing and a shared coder needs no locking.
+int BitSlicedHammingCoder::Correct(const Word *data, size_t number_blocks,
+		Word *corrected_data) {
+	size_t word_length = GetWordLength();
+	size_t syndrome_length = GetSyndromeLength();
+	size_t block_size = word_length * kSliceLength;
+	std::copy(data, data + number_blocks * block_size, corrected_data);
+	Word syndrome[kMaxSyndromeLength * kSliceLength];
+	int ret = kSuccess;
+	for (size_t block_i = 0; block_i < number_blocks; ++block_i) {
+		CalculateSyndrome(data + block_i * block_size, 1, syndrome);
+		Word *corrected_block = corrected_data + block_i * block_size;
+		for (size_t offset = 0; offset < kSliceLength; ++offset) {
+			Word in_error = 0;
+			for (size_t i = 0; i < syndrome_length; ++i) {
+				in_error |= syndrome[i * kSliceLength + offset];
+			}
+			while (in_error) {
+				size_t lane_shift = __builtin_ctzll(in_error);
+				size_t syndrome_value = 0;
+				for (size_t i = 0; i < syndrome_length; ++i) {
+					syndrome_value |= ((syndrome[i * kSliceLength + offset]
+							>> lane_shift) & 1) << i;
+				}
+				size_t error_position = error_table_[syndrome_value];
+				in_error &= in_error - 1;
+				if (error_position == 0) {
+					ret = kUncorrectableError;
+					continue;
+				}
+				corrected_block[(error_position - 1) * kSliceLength + offset] ^=
+						static_cast<Word>(1) << lane_shift;
+			}
+		}
+	}
+	return ret;
+}
+
+int BitSlicedHammingCoder::Decode(const Word *encoded_data,
+		size_t number_blocks, Word *data) {
+	xor_kernel_(receiver_, encoded_data, number_blocks, data);
+	return 0;
+}
+
+int BitSlicedHammingCoder::SetInstructionSet(
+		InstructionSet instruction_set) {
+	if (instruction_set > GetSupportedInstructionSet()) {
+		return 1;
+	}
+	instruction_set_ = instruction_set;
+	xor_kernel_ = GetXorKernel(instruction_set);
+	return 0;
+}
+
+int BitSlicedHammingCoder::BuildRowIndices(Matrix &matrix, RowIndices *rows) {
+	size_t number_rows = matrix.GetNumberRows();
+	size_t number_columns = matrix.GetNumberColums();
+	Matrix::Value *values = matrix.GetElements();
+	rows->number_columns = number_columns;
+	rows->row_offsets.assign(1, 0);
+	rows->indices.clear();
+	for (size_t row_i = 0; row_i < number_rows; ++row_i) {
+		size_t offset = row_i * number_columns;
+		for (size_t column_i = 0; column_i < number_columns; ++column_i) {
+			if (values[offset + column_i] & 1) {
+				rows->indices.push_back(column_i);
+			}
+		}
+		rows->row_offsets.push_back(rows->indices.size());
+	}
+	return 0;
+}
+
+BitSlicedHammingCoder::XorKernel BitSlicedHammingCoder::GetXorKernel(
+		InstructionSet instruction_set) {
+	switch (instruction_set) {
+#ifdef HAMMING_CODE_X86_SIMD
+	case kAvx512:
+		return XorAvx512;
+	case kAvx2:
+		return XorAvx2;
+	case kSse2:
+		return XorSse2;
+#endif
+	default:
+		return XorScalar;
+	}
+}
+
+void BitSlicedHammingCoder::XorScalar(const RowIndices &rows,
+		const Word *input, size_t number_blocks, Word *output) {
+	size_t number_rows = rows.row_offsets.size() - 1;
+	size_t input_block_size = rows.number_columns * kSliceLength;
+	size_t output_block_size = number_rows * kSliceLength;
+	for (size_t block_i = 0; block_i < number_blocks; ++block_i) {
+		const Word *input_block = input + block_i * input_block_size;
+		Word *output_block = output + block_i * output_block_size;
+		for (size_t row_i = 0; row_i < number_rows; ++row_i) {
+			Word slice[kSliceLength] = { 0 };
+			for (size_t i = rows.row_offsets[row_i];
+					i < rows.row_offsets[row_i + 1]; ++i) {
+				const Word *input_slice = input_block
+						+ rows.indices[i] * kSliceLength;
+				for (size_t offset = 0; offset < kSliceLength; ++offset) {
+					slice[offset] ^= input_slice[offset];
+				}
+			}
+			std::copy(slice, slice + kSliceLength,
+					output_block + row_i * kSliceLength);
+		}
+	}
+}
+
+#ifdef HAMMING_CODE_X86_SIMD
+__attribute__((target("sse2")))
+void BitSlicedHammingCoder::XorSse2(const RowIndices &rows,
+		const Word *input, size_t number_blocks, Word *output) {
+	size_t number_rows = rows.row_offsets.size() - 1;
+	size_t input_block_size = rows.number_columns * kSliceLength;
+	size_t output_block_size = number_rows * kSliceLength;
+	for (size_t block_i = 0; block_i < number_blocks; ++block_i) {
+		const Word *input_block = input + block_i * input_block_size;
+		Word *output_block = output + block_i * output_block_size;
+		for (size_t row_i = 0; row_i < number_rows; ++row_i) {
+			__m128i slice0 = _mm_setzero_si128();
+			__m128i slice1 = _mm_setzero_si128();
+			__m128i slice2 = _mm_setzero_si128();
+			__m128i slice3 = _mm_setzero_si128();
+			for (size_t i = rows.row_offsets[row_i];
+					i < rows.row_offsets[row_i + 1]; ++i) {
+				const __m128i *input_slice =
+						reinterpret_cast<const __m128i *>(input_block
+								+ rows.indices[i] * kSliceLength);
+				slice0 = _mm_xor_si128(slice0, _mm_loadu_si128(input_slice));
+				slice1 = _mm_xor_si128(slice1,
+						_mm_loadu_si128(input_slice + 1));
+				slice2 = _mm_xor_si128(slice2,
+						_mm_loadu_si128(input_slice + 2));
+				slice3 = _mm_xor_si128(slice3,
+						_mm_loadu_si128(input_slice + 3));
+			}
+			__m128i *output_slice = reinterpret_cast<__m128i *>(output_block
+					+ row_i * kSliceLength);
+			_mm_storeu_si128(output_slice, slice0);
+			_mm_storeu_si128(output_slice + 1, slice1);
+			_mm_storeu_si128(output_slice + 2, slice2);
+			_mm_storeu_si128(output_slice + 3, slice3);
+		}
+	}
+}
+
+__attribute__((target("avx2")))
+void BitSlicedHammingCoder::XorAvx2(const RowIndices &rows,
+		const Word *input, size_t number_blocks, Word *output) {
+	size_t number_rows = rows.row_offsets.size() - 1;
+	size_t input_block_size = rows.number_columns * kSliceLength;
+	size_t output_block_size = number_rows * kSliceLength;
+	for (size_t block_i = 0; block_i < number_blocks; ++block_i) {
+		const Word *input_block = input + block_i * input_block_size;
+		Word *output_block = output + block_i * output_block_size;
+		for (size_t row_i = 0; row_i < number_rows; ++row_i) {
+			__m256i slice0 = _mm256_setzero_si256();
+			__m256i slice1 = _mm256_setzero_si256();
+			for (size_t i = rows.row_offsets[row_i];
+					i < rows.row_offsets[row_i + 1]; ++i) {
+				const __m256i *input_slice =
+						reinterpret_cast<const __m256i *>(input_block
+								+ rows.indices[i] * kSliceLength);
+				slice0 = _mm256_xor_si256(slice0,
+						_mm256_loadu_si256(input_slice));
+				slice1 = _mm256_xor_si256(slice1,
+						_mm256_loadu_si256(input_slice + 1));
+			}
+			__m256i *output_slice = reinterpret_cast<__m256i *>(output_block
+					+ row_i * kSliceLength);
+			_mm256_storeu_si256(output_slice, slice0);
+			_mm256_storeu_si256(output_slice + 1, slice1);
+		}
+	}
+}
+
+__attribute__((target("avx512f")))
+void BitSlicedHammingCoder::XorAvx512(const RowIndices &rows,
+		const Word *input, size_t number_blocks, Word *output) {
+	size_t number_rows = rows.row_offsets.size() - 1;
+	size_t input_block_size = rows.number_columns * kSliceLength;
+	size_t output_block_size = number_rows * kSliceLength;
+	for (size_t block_i = 0; block_i < number_blocks; ++block_i) {
+		const Word *input_block = input + block_i * input_block_size;
+		Word *output_block = output + block_i * output_block_size;
+		for (size_t row_i = 0; row_i < number_rows; ++row_i) {
+			__m512i slice = _mm512_setzero_si512();
+			for (size_t i = rows.row_offsets[row_i];
+					i < rows.row_offsets[row_i + 1]; ++i) {
+				slice = _mm512_xor_si512(slice,
+						_mm512_loadu_si512(
+								input_block + rows.indices[i] * kSliceLength));
+			}
+			_mm512_storeu_si512(output_block + row_i * kSliceLength, slice);
+		}
+	}
+}
+#endif
+
+int BitSlicedHammingCoder::BuildErrorTable(Matrix &checker_matrix) {
+	size_t syndrome_length = checker_matrix.GetNumberRows();
+	size_t word_length = checker_matrix.GetNumberColums();
+	assert(syndrome_length <= kMaxSyndromeLength);
+	error_table_.assign(static_cast<size_t>(1) << syndrome_length, 0);
+	Matrix::Value *values = checker_matrix.GetElements();
+	for (size_t column_i = 0; column_i < word_length; ++column_i) {
+		size_t syndrome_value = 0;
+		for (size_t row_i = 0; row_i < syndrome_length; ++row_i) {
+			syndrome_value |= static_cast<size_t>(values[row_i * word_length
+					+ column_i] & 1) << row_i;
+		}
+		error_table_[syndrome_value] = column_i + 1;
+	}
+	error_table_[0] = 0;
+	return 0;
+}
+
+} /* namespace hamming_code */
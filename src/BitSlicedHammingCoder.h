@@ -0,0 +1,153 @@
+/*
+ * BitSlicedHammingCoder.h
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BITSLICEDHAMMINGCODER_H_
+#define BITSLICEDHAMMINGCODER_H_
+
+#include <stdint.h>
+#include <vector>
+#include "Matrix.h"
+
+namespace hamming_code {
+
+/*
+ * Binary Hamming coder working on blocks of kBlockLength words in bit-sliced
+ * form.
+ *
+ * A block stores one slice of kSliceLength Words per symbol position, and
+ * bit j of slice i is the i-th symbol of the j-th word in the block. Every
+ * output slice is then the XOR of the input slices selected by the nonzero
+ * elements of a matrix row, which is computed with the widest SIMD
+ * instruction set available on the running CPU.
+ *
+ * The coder stands alone rather than as a HammingCoder engine: its speed
+ * comes from data that stays bit-sliced, which converting from and to the
+ * one symbol per value layout of HammingCoder on every call would undo.
+ */
+class BitSlicedHammingCoder {
+public:
+	typedef uint64_t Word;
+
+	enum InstructionSet {
+		kScalar, kSse2, kAvx2, kAvx512
+	};
+
+	static const size_t kBlockLength = 512;
+	static const size_t kSliceLength = kBlockLength / (sizeof(Word) * 8);
+
+	static InstructionSet GetSupportedInstructionSet();
+
+	static size_t GetNumberBlocks(size_t number_words) {
+		return (number_words + kBlockLength - 1) / kBlockLength;
+	}
+
+	// Converts packed words (see BinaryHammingCoder) to bit-sliced blocks and
+	// back. The last block is padded with zero words.
+	static int Slice(const Word *words, size_t number_words,
+			size_t word_length, Word *slices);
+	static int Unslice(const Word *slices, size_t number_words,
+			size_t word_length, Word *words);
+
+	BitSlicedHammingCoder();
+	BitSlicedHammingCoder(Matrix &generator_matrix, Matrix &checker_matrix,
+			Matrix &receiver_matrix);
+
+	virtual ~BitSlicedHammingCoder();
+
+	int Encode(const Word *data, size_t number_blocks, Word *encoded_data);
+	int CalculateSyndrome(const Word *data, size_t number_blocks,
+			Word *syndrome);
+	int Correct(const Word *data, size_t number_blocks, Word *corrected_data);
+	int Decode(const Word *encoded_data, size_t number_blocks, Word *data);
+
+	InstructionSet GetInstructionSet() const {
+		return instruction_set_;
+	}
+
+	// Returns 1 if the instruction set is not supported on this CPU.
+	int SetInstructionSet(InstructionSet instruction_set);
+
+	size_t GetWordLength() const {
+		return generator_.row_offsets.size() - 1;
+	}
+
+	size_t GetDataLength() const {
+		return receiver_.row_offsets.size() - 1;
+	}
+
+	size_t GetSyndromeLength() const {
+		return checker_.row_offsets.size() - 1;
+	}
+
+private:
+	// Syndromes index error_table_, so they must fit in a size_t.
+	static const size_t kMaxSyndromeLength = sizeof(size_t) * 8 - 1;
+
+	// Positions of the nonzero elements of each matrix row.
+	struct RowIndices {
+		RowIndices() :
+				number_columns(0), row_offsets(1, 0) {
+		}
+
+		size_t number_columns;
+		std::vector<size_t> row_offsets;
+		std::vector<size_t> indices;
+	};
+
+	typedef void (*XorKernel)(const RowIndices &rows, const Word *input,
+			size_t number_blocks, Word *output);
+
+	static int BuildRowIndices(Matrix &matrix, RowIndices *rows);
+	static XorKernel GetXorKernel(InstructionSet instruction_set);
+	static void XorScalar(const RowIndices &rows, const Word *input,
+			size_t number_blocks, Word *output);
+	static void XorSse2(const RowIndices &rows, const Word *input,
+			size_t number_blocks, Word *output);
+	static void XorAvx2(const RowIndices &rows, const Word *input,
+			size_t number_blocks, Word *output);
+	static void XorAvx512(const RowIndices &rows, const Word *input,
+			size_t number_blocks, Word *output);
+
+	int BuildErrorTable(Matrix &checker_matrix);
+
+	InstructionSet instruction_set_;
+	XorKernel xor_kernel_;
+	RowIndices generator_;
+	RowIndices checker_;
+	RowIndices receiver_;
+	std::vector<size_t> error_table_;
+};
+
+} /* namespace hamming_code */
+#endif /* BITSLICEDHAMMINGCODER_H_ */
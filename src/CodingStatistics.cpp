@@ -0,0 +1,178 @@
+/*
+ * CodingStatistics.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CodingStatistics.h"
+#include <time.h>
+
+namespace hamming_code {
+
+const size_t CodingStatistics::kNumberLatencyBuckets;
+
+CodingStatistics::CodingStatistics(size_t word_length, uint8_t alphabet_size,
+		bool measure_latencies) :
+		word_length_(word_length), alphabet_size_(alphabet_size), measure_latencies_(
+				measure_latencies), positions_offset_(kNumberCounters), values_offset_(
+				positions_offset_ + word_length), latencies_offset_(
+				values_offset_ + alphabet_size), shards_(NULL) {
+	size_t length = latencies_offset_
+			+ (measure_latencies_ ? kNumberOperations * kNumberLatencyBuckets : 0);
+	shard_length_ = (length + kCacheLineWords - 1) / kCacheLineWords
+			* kCacheLineWords;
+	storage_.assign(kNumberShards * shard_length_ + kCacheLineWords, 0);
+	uintptr_t address = reinterpret_cast<uintptr_t>(&storage_[0]);
+	size_t misalignment = address % (kCacheLineWords * sizeof(uint64_t));
+	shards_ = &storage_[0]
+			+ (misalignment == 0 ?
+					0 :
+					(kCacheLineWords * sizeof(uint64_t) - misalignment)
+							/ sizeof(uint64_t));
+}
+
+CodingStatistics::~CodingStatistics() {
+
+}
+
+int CodingStatistics::GetSnapshot(Snapshot *snapshot) const {
+	snapshot->number_encoded_words = Sum(kEncodedWords);
+	snapshot->number_checked_words = Sum(kCheckedWords);
+	snapshot->number_decoded_words = Sum(kDecodedWords);
+	snapshot->number_verified_words = Sum(kVerifiedWords);
+	snapshot->number_corrected_words = Sum(kCorrectedWords);
+	snapshot->number_uncorrectable_words = Sum(kUncorrectableWords);
+	uint64_t number_errors = snapshot->number_corrected_words
+			+ snapshot->number_uncorrectable_words;
+	snapshot->number_clean_words =
+			snapshot->number_checked_words > number_errors ?
+					snapshot->number_checked_words - number_errors : 0;
+	snapshot->error_positions.resize(word_length_);
+	for (size_t i = 0; i < word_length_; ++i) {
+		snapshot->error_positions[i] = Sum(positions_offset_ + i);
+	}
+	snapshot->error_values.resize(alphabet_size_);
+	for (size_t i = 0; i < alphabet_size_; ++i) {
+		snapshot->error_values[i] = Sum(values_offset_ + i);
+	}
+	for (size_t operation_i = 0; operation_i < kNumberOperations;
+			++operation_i) {
+		std::vector<uint64_t> &latencies = snapshot->latencies[operation_i];
+		latencies.resize(measure_latencies_ ? kNumberLatencyBuckets : 0);
+		for (size_t i = 0; i < latencies.size(); ++i) {
+			latencies[i] = Sum(
+					latencies_offset_ + operation_i * kNumberLatencyBuckets
+							+ i);
+		}
+	}
+	return 0;
+}
+
+int CodingStatistics::Reset() {
+	for (size_t i = 0; i < kNumberShards * shard_length_; ++i) {
+		__atomic_store_n(&shards_[i], 0, __ATOMIC_RELAXED);
+	}
+	return 0;
+}
+
+uint64_t CodingStatistics::GetStartTime() const {
+	return measure_latencies_ ? GetTime() : 0;
+}
+
+void CodingStatistics::AddCall(Operation operation, size_t number_words,
+		uint64_t start_time) {
+	uint64_t *shard = GetShard();
+	const Counter counters[] = { kEncodedWords, kCheckedWords, kDecodedWords,
+			kVerifiedWords };
+	__atomic_fetch_add(&shard[counters[operation]], number_words,
+			__ATOMIC_RELAXED);
+	if (!measure_latencies_) {
+		return;
+	}
+	uint64_t latency = GetTime() - start_time;
+	size_t bucket_i = 63 - __builtin_clzll(latency | 1);
+	if (bucket_i >= kNumberLatencyBuckets) {
+		bucket_i = kNumberLatencyBuckets - 1;
+	}
+	__atomic_fetch_add(
+			&shard[latencies_offset_ + operation * kNumberLatencyBuckets
+					+ bucket_i], 1, __ATOMIC_RELAXED);
+}
+
+void CodingStatistics::AddCorrectedWord() {
+	__atomic_fetch_add(&GetShard()[kCorrectedWords], 1, __ATOMIC_RELAXED);
+}
+
+void CodingStatistics::AddCorrectedSymbol(size_t error_position,
+		uint8_t error_value) {
+	uint64_t *shard = GetShard();
+	__atomic_fetch_add(&shard[positions_offset_ + error_position], 1,
+			__ATOMIC_RELAXED);
+	__atomic_fetch_add(&shard[values_offset_ + error_value], 1,
+			__ATOMIC_RELAXED);
+}
+
+void CodingStatistics::AddUncorrectableWord() {
+	__atomic_fetch_add(&GetShard()[kUncorrectableWords], 1, __ATOMIC_RELAXED);
+}
+
+// Threads are numbered in the order of their first update; beyond
+// kNumberShards threads, shards are shared, which stays correct.
+size_t CodingStatistics::GetShardIndex() {
+	static size_t number_threads = 0;
+	static __thread size_t thread_number = 0;
+	if (thread_number == 0) {
+		thread_number = __atomic_add_fetch(&number_threads, 1,
+				__ATOMIC_RELAXED);
+	}
+	return (thread_number - 1) % kNumberShards;
+}
+
+uint64_t CodingStatistics::GetTime() {
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return static_cast<uint64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+}
+
+uint64_t *CodingStatistics::GetShard() {
+	return shards_ + GetShardIndex() * shard_length_;
+}
+
+uint64_t CodingStatistics::Sum(size_t counter_i) const {
+	uint64_t sum = 0;
+	for (size_t shard_i = 0; shard_i < kNumberShards; ++shard_i) {
+		sum += __atomic_load_n(&shards_[shard_i * shard_length_ + counter_i],
+				__ATOMIC_RELAXED);
+	}
+	return sum;
+}
+
+} /* namespace hamming_code */
@@ -0,0 +1,139 @@
+/*
+ * CodingStatistics.h
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CODINGSTATISTICS_H_
+#define CODINGSTATISTICS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace hamming_code {
+
+/*
+ * Counters of a HammingCoder, see HammingCoder::SetStatistics.
+ *
+ * Counters are split into cache-line aligned shards and every thread adds to
+ * its own shard with relaxed atomics, so coding threads do not contend.
+ * Clean words cost nothing per word: a call adds its word count once and
+ * only erroneous words are counted individually. GetSnapshot sums the
+ * shards and may run concurrently with coding.
+ */
+class CodingStatistics {
+public:
+	enum Operation {
+		kEncode, kCorrect, kDecode, kVerify, kNumberOperations
+	};
+
+	// Latency bucket i counts calls that took [2^i, 2^(i+1)) ns; the last
+	// bucket also counts longer calls.
+	static const size_t kNumberLatencyBuckets = 32;
+
+	struct Snapshot {
+		uint64_t number_encoded_words;
+		uint64_t number_checked_words;
+		uint64_t number_decoded_words;
+		uint64_t number_verified_words;
+		uint64_t number_clean_words;
+		uint64_t number_corrected_words;
+		uint64_t number_uncorrectable_words;
+		// Corrected symbols by error position and by error value; a word
+		// with two corrected erasures counts in two positions.
+		std::vector<uint64_t> error_positions;
+		std::vector<uint64_t> error_values;
+		// Empty unless latencies are measured.
+		std::vector<uint64_t> latencies[kNumberOperations];
+	};
+
+	CodingStatistics(size_t word_length, uint8_t alphabet_size,
+			bool measure_latencies = false);
+
+	virtual ~CodingStatistics();
+
+	int GetSnapshot(Snapshot *snapshot) const;
+	int Reset();
+
+	size_t GetWordLength() const {
+		return word_length_;
+	}
+
+	uint8_t GetAlphabetSize() const {
+		return alphabet_size_;
+	}
+
+	// Used by HammingCoder. GetStartTime returns 0 when latencies are not
+	// measured.
+	uint64_t GetStartTime() const;
+	void AddCall(Operation operation, size_t number_words, uint64_t start_time);
+	void AddCorrectedWord();
+	void AddCorrectedSymbol(size_t error_position, uint8_t error_value);
+	void AddUncorrectableWord();
+
+private:
+	static const size_t kNumberShards = 16;
+	static const size_t kCacheLineWords = 64 / sizeof(uint64_t);
+
+	enum Counter {
+		kEncodedWords,
+		kCheckedWords,
+		kDecodedWords,
+		kVerifiedWords,
+		kCorrectedWords,
+		kUncorrectableWords,
+		kNumberCounters
+	};
+
+	static size_t GetShardIndex();
+	static uint64_t GetTime();
+
+	CodingStatistics(const CodingStatistics &);
+	CodingStatistics &operator=(const CodingStatistics &);
+
+	uint64_t *GetShard();
+	uint64_t Sum(size_t counter_i) const;
+
+	size_t word_length_;
+	uint8_t alphabet_size_;
+	bool measure_latencies_;
+	// Offsets of the counter groups within a shard.
+	size_t positions_offset_;
+	size_t values_offset_;
+	size_t latencies_offset_;
+	size_t shard_length_;
+	std::vector<uint64_t> storage_;
+	uint64_t *shards_;
+};
+
+} /* namespace hamming_code */
+#endif /* CODINGSTATISTICS_H_ */
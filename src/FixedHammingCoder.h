@@ -0,0 +1,240 @@
+/*
+ * FixedHammingCoder.h
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FIXEDHAMMINGCODER_H_
+#define FIXEDHAMMINGCODER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Matrix.h"
+
+namespace hamming_code {
+
+namespace fixed_hamming_coder {
+
+typedef uint64_t Word;
+
+inline Word Parity(Word word) {
+	return __builtin_popcountll(word) & 1;
+}
+
+// Position of the I-th data symbol. Positions p with p + 1 a power of two
+// hold the parity symbols.
+template<size_t I> struct DataPosition {
+	static const size_t kPrevious = DataPosition<I - 1>::value;
+	static const size_t value =
+			((kPrevious + 2) & (kPrevious + 1)) == 0 ?
+					kPrevious + 2 : kPrevious + 1;
+};
+
+template<> struct DataPosition<0> {
+	static const size_t value = 2;
+};
+
+// Data symbols among the first I that are checked by parity symbol J.
+template<size_t J, size_t I> struct DataMask {
+	static const Word value = DataMask<J, I - 1>::value
+			| (static_cast<Word>(((DataPosition<I - 1>::value + 1) >> J) & 1)
+					<< (I - 1));
+};
+
+template<size_t J> struct DataMask<J, 0> {
+	static const Word value = 0;
+};
+
+// Positions among the first P that are checked by parity symbol J.
+template<size_t J, size_t P> struct CheckMask {
+	static const Word value = CheckMask<J, P - 1>::value
+			| (static_cast<Word>((P >> J) & 1) << (P - 1));
+};
+
+template<size_t J> struct CheckMask<J, 0> {
+	static const Word value = 0;
+};
+
+// Parity symbols 0, ..., J - 1 of a code word with K data symbols.
+template<size_t K, size_t J> struct Parities {
+	static Word Encode(Word data) {
+		return Parities<K, J - 1>::Encode(data)
+				| (Parity(data & DataMask<J - 1, K>::value)
+						<< ((static_cast<size_t>(1) << (J - 1)) - 1));
+	}
+};
+
+template<size_t K> struct Parities<K, 0> {
+	static Word Encode(Word) {
+		return 0;
+	}
+};
+
+// Syndrome symbols 0, ..., J - 1 of a code word of length N.
+template<size_t N, size_t J> struct Syndrome {
+	static Word Calculate(Word word) {
+		return Syndrome<N, J - 1>::Calculate(word)
+				| (Parity(word & CheckMask<J - 1, N>::value) << (J - 1));
+	}
+};
+
+template<size_t N> struct Syndrome<N, 0> {
+	static Word Calculate(Word) {
+		return 0;
+	}
+};
+
+// Data symbols between the parity symbols 2^(J-1) - 1 and 2^J - 1 are
+// consecutive, so they move as one run.
+template<size_t J> struct Run {
+	static const size_t kPosition = (static_cast<size_t>(1) << (J - 1));
+	static const size_t kLength = kPosition - 1;
+	static const size_t kOffset = kPosition - J;
+	static const Word kMask = (static_cast<Word>(1) << kLength) - 1;
+};
+
+template<size_t J> struct Runs {
+	static Word Deposit(Word data) {
+		return Runs<J - 1>::Deposit(data)
+				| (((data >> Run<J>::kOffset) & Run<J>::kMask)
+						<< Run<J>::kPosition);
+	}
+
+	static Word Extract(Word word) {
+		return Runs<J - 1>::Extract(word)
+				| (((word >> Run<J>::kPosition) & Run<J>::kMask)
+						<< Run<J>::kOffset);
+	}
+};
+
+template<> struct Runs<1> {
+	static Word Deposit(Word) {
+		return 0;
+	}
+
+	static Word Extract(Word) {
+		return 0;
+	}
+};
+
+template<size_t N> struct SyndromeLength {
+	static const size_t value = SyndromeLength<N / 2>::value + 1;
+};
+
+template<> struct SyndromeLength<0> {
+	static const size_t value = 0;
+};
+
+} /* namespace fixed_hamming_coder */
+
+/*
+ * Hamming coder whose geometry is fixed at compile time.
+ *
+ * Words are packed as in BinaryHammingCoder and the code has the usual
+ * layout with parity symbols at positions 2^j - 1, so the syndrome of a word
+ * with one error is the error position plus one and no error table is
+ * needed. All masks are compile time constants and every loop is unrolled by
+ * template recursion. Only the binary alphabet is supported.
+ */
+template<size_t N, size_t K, uint8_t Q = 2>
+class FixedHammingCoder {
+public:
+	typedef fixed_hamming_coder::Word Word;
+
+	static const size_t kWordLength = N;
+	static const size_t kDataLength = K;
+	static const size_t kSyndromeLength = N - K;
+
+	int Encode(Word data, Word *encoded_data) const {
+		*encoded_data = fixed_hamming_coder::Runs<kSyndromeLength>::Deposit(
+				data)
+				| fixed_hamming_coder::Parities<K, kSyndromeLength>::Encode(
+						data);
+		return 0;
+	}
+
+	int Correct(Word data, Word *corrected_data) const {
+		Word syndrome = fixed_hamming_coder::Syndrome<N, kSyndromeLength>::Calculate(
+				data);
+		*corrected_data = data
+				^ (static_cast<Word>(syndrome != 0) << ((syndrome - 1) & 63));
+		return 0;
+	}
+
+	int Decode(Word encoded_data, Word *data) const {
+		*data = fixed_hamming_coder::Runs<kSyndromeLength>::Extract(
+				encoded_data);
+		return 0;
+	}
+
+	static int GetMatrices(Matrix *generator_matrix, Matrix *checker_matrix,
+			Matrix *receiver_matrix) {
+		*generator_matrix = Matrix(N, K);
+		*checker_matrix = Matrix(kSyndromeLength, N);
+		*receiver_matrix = Matrix(K, N);
+		FixedHammingCoder coder;
+		for (size_t i = 0; i < K; ++i) {
+			Word encoded_data = 0;
+			coder.Encode(static_cast<Word>(1) << i, &encoded_data);
+			for (size_t position = 0; position < N; ++position) {
+				generator_matrix->SetElement(position, i,
+						(encoded_data >> position) & 1);
+			}
+			Word data = 0;
+			for (size_t position = 0; position < N; ++position) {
+				coder.Decode(static_cast<Word>(1) << position, &data);
+				receiver_matrix->SetElement(i, position, (data >> i) & 1);
+			}
+		}
+		for (size_t position = 0; position < N; ++position) {
+			for (size_t j = 0; j < kSyndromeLength; ++j) {
+				checker_matrix->SetElement(j, position,
+						((position + 1) >> j) & 1);
+			}
+		}
+		return 0;
+	}
+
+private:
+	typedef char BinaryAlphabetOnly[Q == 2 ? 1 : -1];
+	typedef char HammingCodeLengthOnly[
+			N + 1 == (static_cast<size_t>(1) << (N - K))
+					&& fixed_hamming_coder::SyndromeLength<N>::value == N - K
+					&& N <= 64 ? 1 : -1];
+};
+
+typedef FixedHammingCoder<7, 4> HammingCoder7_4;
+typedef FixedHammingCoder<15, 11> HammingCoder15_11;
+typedef FixedHammingCoder<31, 26> HammingCoder31_26;
+typedef FixedHammingCoder<63, 57> HammingCoder63_57;
+
+} /* namespace hamming_code */
+#endif /* FIXEDHAMMINGCODER_H_ */
@@ -0,0 +1,107 @@
+/*
+ * GaloisField.h
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GALOISFIELD_H_
+#define GALOISFIELD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "Matrix.h"
+
+namespace hamming_code {
+
+/*
+ * Arithmetic modulo the alphabet size q of a code, GF(q) for prime q.
+ *
+ * Elements are Values in [0, q). Sums of products are accumulated in int and
+ * reduced once with Barrett reduction, so no intermediate wraps in a Value
+ * and no division is executed.
+ */
+class GaloisField {
+public:
+	explicit GaloisField(uint8_t order = 2);
+
+	virtual ~GaloisField();
+
+	// Any value below 2^32.
+	Matrix::Value Reduce(uint32_t value) const {
+		uint32_t quotient = static_cast<uint32_t>((static_cast<uint64_t>(value)
+				* multiplier_) >> 32);
+		uint32_t rest = value - quotient * order_;
+		return rest >= order_ ? rest - order_ : rest;
+	}
+
+	// Any Value, e.g. a negative entry of a user supplied matrix.
+	Matrix::Value Normalize(Matrix::Value value) const {
+		int rest = value % static_cast<int>(order_);
+		return rest < 0 ? rest + order_ : rest;
+	}
+
+	Matrix::Value Add(Matrix::Value a, Matrix::Value b) const {
+		int sum = a + b;
+		return sum >= static_cast<int>(order_) ? sum - order_ : sum;
+	}
+
+	Matrix::Value Subtract(Matrix::Value a, Matrix::Value b) const {
+		int difference = a - b;
+		return difference < 0 ? difference + order_ : difference;
+	}
+
+	Matrix::Value Multiply(Matrix::Value a, Matrix::Value b) const {
+		return products_[a * order_ + b];
+	}
+
+	// The multiplicative inverse of a nonzero element.
+	Matrix::Value Inverse(Matrix::Value a) const {
+		return inverses_[a];
+	}
+
+	uint8_t GetOrder() const {
+		return order_;
+	}
+
+	// Only prime orders form a field; otherwise some inverses are 0.
+	static bool IsPrime(size_t n);
+
+private:
+	uint32_t order_;
+	// floor(2^32 / order_), 0 while order_ < 2.
+	uint64_t multiplier_;
+	std::vector<Matrix::Value> products_;
+	std::vector<Matrix::Value> inverses_;
+};
+
+} /* namespace hamming_code */
+#endif /* GALOISFIELD_H_ */
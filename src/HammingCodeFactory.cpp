@@ -0,0 +1,192 @@
+/*
+ * HammingCodeFactory.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "HammingCodeFactory.h"
+#include <vector>
+#include "GaloisField.h"
+
+namespace hamming_code {
+
+const uint8_t HammingCodeFactory::kMaxAlphabetSize;
+const size_t HammingCodeFactory::kMaxNumberSyndromes;
+
+int HammingCodeFactory::CreateMatrices(uint8_t alphabet_size,
+		size_t redundancy, Matrix *generator_matrix, Matrix *checker_matrix,
+		Matrix *receiver_matrix) {
+	if (!GaloisField::IsPrime(alphabet_size) || alphabet_size > kMaxAlphabetSize
+			|| redundancy < 2) {
+		return kInvalidArgument;
+	}
+	size_t number_vectors = 1;
+	for (size_t i = 0; i < redundancy; ++i) {
+		number_vectors *= alphabet_size;
+		if (number_vectors > kMaxNumberSyndromes) {
+			return kInvalidArgument;
+		}
+	}
+	size_t word_length = (number_vectors - 1) / (alphabet_size - 1);
+	size_t data_length = word_length - redundancy;
+
+	// The columns of A are the nonzero vectors whose first nonzero element
+	// is 1, except the unit vectors that make up the identity part.
+	std::vector<Matrix::Value> column(redundancy);
+	std::vector<Matrix::Value> a_values;
+	for (size_t v = 1; v < number_vectors; ++v) {
+		size_t rest = v;
+		size_t weight = 0;
+		size_t first_nonzero = redundancy;
+		for (size_t row_i = 0; row_i < redundancy; ++row_i) {
+			column[row_i] = rest % alphabet_size;
+			rest /= alphabet_size;
+			if (column[row_i] != 0) {
+				++weight;
+				if (first_nonzero == redundancy) {
+					first_nonzero = row_i;
+				}
+			}
+		}
+		if (column[first_nonzero] != 1 || weight == 1) {
+			continue;
+		}
+		a_values.insert(a_values.end(), column.begin(), column.end());
+	}
+
+	*generator_matrix = Matrix(word_length, data_length);
+	*checker_matrix = Matrix(redundancy, word_length);
+	*receiver_matrix = Matrix(data_length, word_length);
+	for (size_t data_i = 0; data_i < data_length; ++data_i) {
+		generator_matrix->SetElement(data_i, data_i, 1);
+		receiver_matrix->SetElement(data_i, data_i, 1);
+		for (size_t row_i = 0; row_i < redundancy; ++row_i) {
+			Matrix::Value a = a_values[data_i * redundancy + row_i];
+			checker_matrix->SetElement(row_i, data_i, a);
+			generator_matrix->SetElement(data_length + row_i, data_i,
+					(alphabet_size - a) % alphabet_size);
+		}
+	}
+	for (size_t row_i = 0; row_i < redundancy; ++row_i) {
+		checker_matrix->SetElement(row_i, data_length + row_i, 1);
+	}
+	return kSuccess;
+}
+
+int HammingCodeFactory::CreateCoder(uint8_t alphabet_size, size_t redundancy,
+		HammingCoder *coder) {
+	Matrix generator_matrix;
+	Matrix checker_matrix;
+	Matrix receiver_matrix;
+	if (CreateMatrices(alphabet_size, redundancy, &generator_matrix,
+			&checker_matrix, &receiver_matrix) != 0) {
+		return kInvalidArgument;
+	}
+	*coder = HammingCoder(alphabet_size, generator_matrix, checker_matrix,
+			receiver_matrix);
+	return kSuccess;
+}
+
+int HammingCodeFactory::ExtendMatrices(Matrix &generator_matrix,
+		Matrix &checker_matrix, Matrix &receiver_matrix,
+		Matrix *extended_generator_matrix, Matrix *extended_checker_matrix,
+		Matrix *extended_receiver_matrix) {
+	size_t word_length = generator_matrix.GetNumberRows();
+	size_t data_length = generator_matrix.GetNumberColums();
+	size_t syndrome_length = checker_matrix.GetNumberRows();
+	if (checker_matrix.GetNumberColums() != word_length
+			|| receiver_matrix.GetNumberRows() != data_length
+			|| receiver_matrix.GetNumberColums() != word_length) {
+		return kInvalidArgument;
+	}
+	Matrix extended_generator(word_length + 1, data_length);
+	for (size_t column_i = 0; column_i < data_length; ++column_i) {
+		Matrix::Value parity = 0;
+		for (size_t row_i = 0; row_i < word_length; ++row_i) {
+			Matrix::Value value = generator_matrix.GetElement(row_i, column_i);
+			extended_generator.SetElement(row_i, column_i, value);
+			parity ^= value & 1;
+		}
+		extended_generator.SetElement(word_length, column_i, parity);
+	}
+	Matrix extended_checker(syndrome_length + 1, word_length + 1);
+	for (size_t row_i = 0; row_i < syndrome_length; ++row_i) {
+		for (size_t column_i = 0; column_i < word_length; ++column_i) {
+			extended_checker.SetElement(row_i, column_i,
+					checker_matrix.GetElement(row_i, column_i));
+		}
+	}
+	for (size_t column_i = 0; column_i <= word_length; ++column_i) {
+		extended_checker.SetElement(syndrome_length, column_i, 1);
+	}
+	Matrix extended_receiver(data_length, word_length + 1);
+	for (size_t row_i = 0; row_i < data_length; ++row_i) {
+		for (size_t column_i = 0; column_i < word_length; ++column_i) {
+			extended_receiver.SetElement(row_i, column_i,
+					receiver_matrix.GetElement(row_i, column_i));
+		}
+	}
+	*extended_generator_matrix = extended_generator;
+	*extended_checker_matrix = extended_checker;
+	*extended_receiver_matrix = extended_receiver;
+	return kSuccess;
+}
+
+int HammingCodeFactory::CreateExtendedMatrices(uint8_t alphabet_size,
+		size_t redundancy, Matrix *generator_matrix, Matrix *checker_matrix,
+		Matrix *receiver_matrix) {
+	Matrix generator;
+	Matrix checker;
+	Matrix receiver;
+	if (alphabet_size != 2
+			|| CreateMatrices(alphabet_size, redundancy, &generator, &checker,
+					&receiver) != 0) {
+		return kInvalidArgument;
+	}
+	return ExtendMatrices(generator, checker, receiver, generator_matrix,
+			checker_matrix, receiver_matrix);
+}
+
+int HammingCodeFactory::CreateExtendedCoder(uint8_t alphabet_size,
+		size_t redundancy, HammingCoder *coder) {
+	Matrix generator_matrix;
+	Matrix checker_matrix;
+	Matrix receiver_matrix;
+	if (CreateExtendedMatrices(alphabet_size, redundancy, &generator_matrix,
+			&checker_matrix, &receiver_matrix) != 0) {
+		return kInvalidArgument;
+	}
+	*coder = HammingCoder(alphabet_size, generator_matrix, checker_matrix,
+			receiver_matrix);
+	return kSuccess;
+}
+
+} /* namespace hamming_code */
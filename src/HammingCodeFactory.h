@@ -0,0 +1,86 @@
+/*
+ * HammingCodeFactory.h
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HAMMINGCODEFACTORY_H_
+#define HAMMINGCODEFACTORY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "HammingCoder.h"
+#include "Matrix.h"
+#include "Status.h"
+
+namespace hamming_code {
+
+/*
+ * Builds the Hamming code with redundancy r over a prime alphabet q.
+ *
+ * The code length is (q^r - 1) / (q - 1) and the matrices are systematic: a
+ * code word is the data word followed by r parity symbols, the checker
+ * matrix is [A | I] and the generator matrix is [I ; -A], so decoding only
+ * copies the first symbols.
+ */
+class HammingCodeFactory {
+public:
+	// Symbols are Matrix::Value, a char.
+	static const uint8_t kMaxAlphabetSize = 127;
+	// Largest q^r. The error table of a coder has q^r entries and the dense
+	// matrices about (q^r / (q - 1))^2 elements, 268 MB for q = 2, r = 14.
+	static const size_t kMaxNumberSyndromes = 1 << 14;
+
+	// Returns kInvalidArgument if the alphabet size is not a prime of at most
+	// kMaxAlphabetSize, the redundancy is smaller than 2 or q^r is larger
+	// than kMaxNumberSyndromes.
+	static int CreateMatrices(uint8_t alphabet_size, size_t redundancy,
+			Matrix *generator_matrix, Matrix *checker_matrix,
+			Matrix *receiver_matrix);
+	static int CreateCoder(uint8_t alphabet_size, size_t redundancy,
+			HammingCoder *coder);
+
+	// Appends an overall parity symbol to a binary code. The extended code
+	// corrects single errors and its coders return kUncorrectableError for
+	// double errors, because no single error has an even overall parity and
+	// a nonzero syndrome.
+	static int ExtendMatrices(Matrix &generator_matrix, Matrix &checker_matrix,
+			Matrix &receiver_matrix, Matrix *extended_generator_matrix,
+			Matrix *extended_checker_matrix, Matrix *extended_receiver_matrix);
+	static int CreateExtendedMatrices(uint8_t alphabet_size, size_t redundancy,
+			Matrix *generator_matrix, Matrix *checker_matrix,
+			Matrix *receiver_matrix);
+	static int CreateExtendedCoder(uint8_t alphabet_size, size_t redundancy,
+			HammingCoder *coder);
+};
+
+} /* namespace hamming_code */
+#endif /* HAMMINGCODEFACTORY_H_ */
@@ -34,93 +34,1199 @@
 
 #include "HammingCoder.h"
 #include "Matrix.h"
+#include "Status.h"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <cmath>
+#include <algorithm>
+#include <fstream>
 #include <stdint.h>
 #include <assert.h>
 
 namespace hamming_code {
 
+const size_t HammingCoder::kVerifyChunkLength;
+const size_t HammingCoder::kVerifyBufferLength;
+
+const char HammingCoder::kImageMagic[8] = { 'H', 'M', 'C', 'O', 'D', 'E', 'R',
+		'1' };
+
 HammingCoder::HammingCoder() :
-		alphabet_size_(0) {
+		alphabet_size_(0), engine_(kMatrixEngine), mapped_image_(NULL), mapped_length_(
+				0), statistics_(NULL), error_table_(NULL), data_positions_(NULL), number_data_positions_(
+				0), systematic_(false) {
 
 }
 
 HammingCoder::HammingCoder(uint8_t alphabet_size, Matrix &generator_matrix,
 		Matrix &checker_matrix, Matrix &receiver_matrix) :
-		alphabet_size_(alphabet_size), generator_matrix_(generator_matrix), checker_matrix_(
-				checker_matrix), receiver_matrix_(receiver_matrix) {
-	BuildErrorTable();
+		alphabet_size_(alphabet_size), field_(alphabet_size), engine_(
+				kMatrixEngine), mapped_image_(NULL), mapped_length_(0), statistics_(
+				NULL), error_table_(NULL), data_positions_(NULL), number_data_positions_(0), systematic_(
+				false) {
+	assert(receiver_matrix.GetNumberRows() == generator_matrix.GetNumberColums());
+	assert(GaloisField::IsPrime(alphabet_size));
+	Matrix generator(generator_matrix);
+	Matrix checker(checker_matrix);
+	Matrix receiver(receiver_matrix);
+	NormalizeMatrix(&generator);
+	NormalizeMatrix(&checker);
+	NormalizeMatrix(&receiver);
+	generator_matrix_ = generator;
+	checker_matrix_ = checker;
+	receiver_matrix_ = receiver;
+	BuildImage();
+}
+
+HammingCoder::HammingCoder(const HammingCoder &coder) :
+		alphabet_size_(0), engine_(kMatrixEngine), mapped_image_(NULL), mapped_length_(
+				0), statistics_(NULL), error_table_(NULL), data_positions_(NULL), number_data_positions_(
+				0), systematic_(false) {
+	*this = coder;
+}
+
+HammingCoder &HammingCoder::operator=(const HammingCoder &coder) {
+	if (this == &coder) {
+		return *this;
+	}
+	ReleaseImage();
+	alphabet_size_ = coder.alphabet_size_;
+	field_ = coder.field_;
+	engine_ = coder.engine_;
+	statistics_ = coder.statistics_;
+	const uint64_t *image = coder.GetImage();
+	if (image != NULL) {
+		const ImageHeader *header = reinterpret_cast<const ImageHeader *>(image);
+		image_.assign(image, image + header->image_length / sizeof(uint64_t));
+		AttachImage(&image_[0]);
+	}
+	return *this;
 }
 
 HammingCoder::~HammingCoder() {
+	ReleaseImage();
+}
 
+int HammingCoder::Save(const char *path) const {
+	const uint64_t *image = GetImage();
+	if (image == NULL) {
+		return kInvalidArgument;
+	}
+	const ImageHeader *header = reinterpret_cast<const ImageHeader *>(image);
+	std::ofstream ofstream(path, std::ios::out | std::ios::binary);
+	ofstream.write(reinterpret_cast<const char *>(image), header->image_length);
+	ofstream.close();
+	return ofstream.fail() ? kIoError : kSuccess;
 }
 
-int HammingCoder::Encode(Matrix &data, Matrix *encoded_data) {
-	Matrix::Multiply(generator_matrix_, data, encoded_data);
-	MatrixModulo(*encoded_data, alphabet_size_);
-	return 0;
+int HammingCoder::Load(const char *path, HammingCoder *coder) {
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		return kIoError;
+	}
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+		close(fd);
+		return kIoError;
+	}
+	size_t length = file_stat.st_size;
+	void *image = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (image == MAP_FAILED) {
+		return kIoError;
+	}
+	if (ValidateImage(static_cast<const uint64_t *>(image), length)
+			!= kSuccess) {
+		munmap(image, length);
+		return kInvalidArgument;
+	}
+	coder->ReleaseImage();
+	coder->engine_ = kMatrixEngine;
+	coder->statistics_ = NULL;
+	coder->mapped_image_ = static_cast<const uint64_t *>(image);
+	coder->mapped_length_ = length;
+	return coder->AttachImage(coder->mapped_image_);
 }
 
-int HammingCoder::Correct(Matrix &data, Matrix *corrected_data) {
-	Syndrome syndrome;
-	Matrix::Multiply(checker_matrix_, data, &syndrome);
-	MatrixModulo(syndrome, alphabet_size_);
-	bool in_error = false;
-	size_t length = syndrome.GetNumberRows();
+int HammingCoder::Encode(const Matrix &data, Matrix *encoded_data) const {
+	encoded_data->Resize(generator_matrix_.GetNumberRows(),
+			data.GetNumberColums());
+	MatrixView encoded_view(*encoded_data);
+	return Encode(GetInputView(data), &encoded_view);
+}
+
+int HammingCoder::Correct(const Matrix &data, Matrix *corrected_data) const {
+	corrected_data->Resize(data.GetNumberRows(), data.GetNumberColums());
+	MatrixView corrected_view(*corrected_data);
+	return Correct(GetInputView(data), &corrected_view);
+}
+
+int HammingCoder::Decode(const Matrix &encoded_data, Matrix *data) const {
+	data->Resize(receiver_matrix_.GetNumberRows(),
+			encoded_data.GetNumberColums());
+	MatrixView data_view(*data);
+	return Decode(GetInputView(encoded_data), &data_view);
+}
+
+int HammingCoder::Encode(const MatrixView &data,
+		MatrixView *encoded_data) const {
+	uint64_t start_time = GetStartTime();
+	size_t number_words = data.GetNumberColums();
+	if (engine_ == kTableEngine) {
+		if (data.GetNumberRows() != GetDataLength()
+				|| encoded_data->GetNumberRows() != GetWordLength()
+				|| encoded_data->GetNumberColums() != number_words) {
+			return kInvalidArgument;
+		}
+		for (size_t word_i = 0; word_i < number_words; ++word_i) {
+			EncodeWordByTable(data.GetElements() + word_i, number_words,
+					encoded_data->GetElements() + word_i, number_words);
+		}
+	} else if (SparseMatrix::Multiply(sparse_generator_matrix_, data,
+			encoded_data, &field_) != 0) {
+		return kInvalidArgument;
+	}
+	AddCall(CodingStatistics::kEncode, number_words, start_time);
+	return kSuccess;
+}
+
+int HammingCoder::Correct(const MatrixView &data, MatrixView *corrected_data,
+		MatrixArena *arena) const {
+	if (data.GetNumberRows() != checker_matrix_.GetNumberColums()
+			|| MatrixView::Copy(data, corrected_data) != 0) {
+		return kInvalidArgument;
+	}
+	if (arena == NULL) {
+		return Correct(corrected_data);
+	}
+	uint64_t start_time = GetStartTime();
+	size_t number_words = data.GetNumberColums();
+	Matrix::Value *corrected_values = corrected_data->GetElements();
+	MatrixView syndrome = arena->Allocate(checker_matrix_.GetNumberRows(),
+			number_words);
+	SparseMatrix::Multiply(sparse_checker_matrix_, *corrected_data, &syndrome,
+			&field_);
 	Matrix::Value *syndrome_values = syndrome.GetElements();
-	for (size_t i = 0; i < length; ++i) {
-		if (syndrome_values[i] != 0) {
-			in_error = true;
-			break;
+	int ret = kSuccess;
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		ret |= CorrectWord(
+				GetSyndromeIndex(syndrome_values + word_i, number_words),
+				corrected_values + word_i, number_words);
+	}
+	AddCall(CodingStatistics::kCorrect, number_words, start_time);
+	return ret;
+}
+
+int HammingCoder::Decode(const MatrixView &encoded_data,
+		MatrixView *data) const {
+	uint64_t start_time = GetStartTime();
+	size_t number_words = encoded_data.GetNumberColums();
+	if (number_data_positions_ == 0) {
+		if (SparseMatrix::Multiply(sparse_receiver_matrix_, encoded_data, data,
+				&field_) != 0) {
+			return kInvalidArgument;
 		}
+		AddCall(CodingStatistics::kDecode, number_words, start_time);
+		return kSuccess;
+	}
+	size_t data_length = number_data_positions_;
+	if (encoded_data.GetNumberRows() != receiver_matrix_.GetNumberColums()
+			|| data->GetNumberRows() != data_length
+			|| data->GetNumberColums() != number_words) {
+		return kInvalidArgument;
 	}
-	*corrected_data = data;
-	if (in_error) {
-		ErrorTable::iterator find_it = error_table_.find(syndrome);
-		assert(find_it != error_table_.end());
-		Matrix::Value *error_value = corrected_data->GetElements()
-				+ find_it->second.error_position;
-		*error_value += find_it->second.error_value;
-		if (*error_value >= alphabet_size_) {
-			*error_value -= alphabet_size_;
+	const Matrix::Value *encoded_values = encoded_data.GetElements();
+	Matrix::Value *values = data->GetElements();
+	for (size_t i = 0; i < data_length; ++i) {
+		const Matrix::Value *row = encoded_values
+				+ data_positions_[i] * number_words;
+		std::copy(row, row + number_words, values + i * number_words);
+	}
+	AddCall(CodingStatistics::kDecode, number_words, start_time);
+	return kSuccess;
+}
+
+int HammingCoder::Encode(const Matrix::Value *data, size_t number_words,
+		Matrix::Value *encoded_data) const {
+	uint64_t start_time = GetStartTime();
+	if (engine_ == kTableEngine) {
+		size_t data_length = GetDataLength();
+		size_t word_length = GetWordLength();
+		for (size_t word_i = 0; word_i < number_words; ++word_i) {
+			EncodeWordByTable(data + word_i * data_length, 1,
+					encoded_data + word_i * word_length, 1);
 		}
+	} else {
+		MultiplyWords(sparse_generator_matrix_, data, number_words,
+				encoded_data);
 	}
-	return 0;
+	AddCall(CodingStatistics::kEncode, number_words, start_time);
+	return kSuccess;
+}
+
+int HammingCoder::Correct(const Matrix::Value *data, size_t number_words,
+		Matrix::Value *corrected_data) const {
+	size_t word_length = checker_matrix_.GetNumberColums();
+	std::copy(data, data + number_words * word_length, corrected_data);
+	return Correct(corrected_data, number_words);
+}
+
+int HammingCoder::Decode(const Matrix::Value *encoded_data,
+		size_t number_words, Matrix::Value *data) const {
+	uint64_t start_time = GetStartTime();
+	if (number_data_positions_ == 0) {
+		MultiplyWords(sparse_receiver_matrix_, encoded_data, number_words,
+				data);
+		AddCall(CodingStatistics::kDecode, number_words, start_time);
+		return kSuccess;
+	}
+	size_t data_length = number_data_positions_;
+	size_t word_length = receiver_matrix_.GetNumberColums();
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		const Matrix::Value *word = encoded_data + word_i * word_length;
+		Matrix::Value *ret_word = data + word_i * data_length;
+		if (systematic_) {
+			std::copy(word, word + data_length, ret_word);
+		} else {
+			for (size_t i = 0; i < data_length; ++i) {
+				ret_word[i] = word[data_positions_[i]];
+			}
+		}
+	}
+	AddCall(CodingStatistics::kDecode, number_words, start_time);
+	return kSuccess;
+}
+
+int HammingCoder::Correct(MatrixView *data) const {
+	if (data->GetNumberRows() != checker_matrix_.GetNumberColums()) {
+		return kInvalidArgument;
+	}
+	uint64_t start_time = GetStartTime();
+	size_t number_words = data->GetNumberColums();
+	Matrix::Value *values = data->GetElements();
+	int ret = kSuccess;
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		Matrix::Value *word = values + word_i;
+		ret |= CorrectWord(CalculateSyndromeIndex(word, number_words), word,
+				number_words);
+	}
+	AddCall(CodingStatistics::kCorrect, number_words, start_time);
+	return ret;
+}
+
+int HammingCoder::Correct(Matrix::Value *data, size_t number_words) const {
+	uint64_t start_time = GetStartTime();
+	size_t word_length = checker_matrix_.GetNumberColums();
+	int ret = kSuccess;
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		Matrix::Value *word = data + word_i * word_length;
+		ret |= CorrectWord(CalculateSyndromeIndex(word, 1), word, 1);
+	}
+	AddCall(CodingStatistics::kCorrect, number_words, start_time);
+	return ret;
+}
+
+int HammingCoder::CorrectAndDecode(const MatrixView &encoded_data,
+		MatrixView *data) const {
+	int ret = Decode(encoded_data, data);
+	if (ret != kSuccess) {
+		return ret;
+	}
+	uint64_t start_time = GetStartTime();
+	size_t number_words = encoded_data.GetNumberColums();
+	const Matrix::Value *encoded_values = encoded_data.GetElements();
+	Matrix::Value *values = data->GetElements();
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		ret |= CorrectDecodedWord(
+				CalculateSyndromeIndex(encoded_values + word_i, number_words),
+				values + word_i, number_words);
+	}
+	AddCall(CodingStatistics::kCorrect, number_words, start_time);
+	return ret;
+}
+
+int HammingCoder::CorrectAndDecode(const Matrix::Value *encoded_data,
+		size_t number_words, Matrix::Value *data) const {
+	Decode(encoded_data, number_words, data);
+	uint64_t start_time = GetStartTime();
+	size_t word_length = checker_matrix_.GetNumberColums();
+	size_t data_length = receiver_matrix_.GetNumberRows();
+	int ret = kSuccess;
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		ret |= CorrectDecodedWord(
+				CalculateSyndromeIndex(encoded_data + word_i * word_length, 1),
+				data + word_i * data_length, 1);
+	}
+	AddCall(CodingStatistics::kCorrect, number_words, start_time);
+	return ret;
 }
 
-int HammingCoder::Decode(Matrix &encoded_data, Matrix *data) {
-	return Matrix::Multiply(receiver_matrix_, encoded_data, data);
+int HammingCoder::Verify(const Matrix &data,
+		std::vector<size_t> *dirty_words) const {
+	return Verify(GetInputView(data), dirty_words);
 }
 
-int HammingCoder::BuildErrorTable() {
-	Syndrome syndrome;
-	size_t word_length = generator_matrix_.GetNumberRows();
-	Matrix word(word_length, 1);
-	Matrix::Value *word_values = word.GetElements();
+// Both engines flag the words of a chunk with the sparse checker matrix, so
+// a clean chunk costs one pass over its words and a scan of the flags
+// instead of strided per-word lookups.
+int HammingCoder::Verify(const MatrixView &data,
+		std::vector<size_t> *dirty_words) const {
+	if (data.GetNumberRows() != GetWordLength()) {
+		return kInvalidArgument;
+	}
+	uint64_t start_time = GetStartTime();
+	dirty_words->clear();
+	size_t number_words = data.GetNumberColums();
+	Matrix::Value flags[kVerifyChunkLength];
+	for (size_t word_begin = 0; word_begin < number_words; word_begin +=
+			kVerifyChunkLength) {
+		size_t length = std::min(kVerifyChunkLength, number_words - word_begin);
+		FlagDirtyWords(data, word_begin, length, flags);
+		AddDirtyWords(flags, word_begin, length, dirty_words);
+	}
+	AddCall(CodingStatistics::kVerify, number_words, start_time);
+	return kSuccess;
+}
+
+// Contiguous words are transposed a chunk at a time into a stack buffer,
+// which is then flagged like a view. A word too long for the buffer is a
+// view of one column by itself. The table engine reads each contiguous word
+// by table chunks instead, which is faster than transposing.
+int HammingCoder::Verify(const Matrix::Value *data, size_t number_words,
+		std::vector<size_t> *dirty_words) const {
+	uint64_t start_time = GetStartTime();
+	dirty_words->clear();
+	size_t word_length = GetWordLength();
+	if (engine_ == kTableEngine) {
+		for (size_t word_i = 0; word_i < number_words; ++word_i) {
+			if (CalculateSyndromeIndexByTable(data + word_i * word_length, 1)
+					!= 0) {
+				dirty_words->push_back(word_i);
+			}
+		}
+		AddCall(CodingStatistics::kVerify, number_words, start_time);
+		return kSuccess;
+	}
+	size_t chunk_length = std::min(kVerifyChunkLength,
+			kVerifyBufferLength / word_length);
+	Matrix::Value flags[kVerifyChunkLength];
+	if (chunk_length == 0) {
+		for (size_t word_i = 0; word_i < number_words; ++word_i) {
+			const MatrixView word(word_length, 1,
+					const_cast<Matrix::Value *>(data + word_i * word_length));
+			FlagDirtyWords(word, 0, 1, flags);
+			AddDirtyWords(flags, word_i, 1, dirty_words);
+		}
+		AddCall(CodingStatistics::kVerify, number_words, start_time);
+		return kSuccess;
+	}
+	Matrix::Value buffer[kVerifyBufferLength];
+	for (size_t word_begin = 0; word_begin < number_words; word_begin +=
+			chunk_length) {
+		size_t length = std::min(chunk_length, number_words - word_begin);
+		const Matrix::Value *words = data + word_begin * word_length;
+		for (size_t word_i = 0; word_i < length; ++word_i) {
+			const Matrix::Value *word = words + word_i * word_length;
+			for (size_t i = 0; i < word_length; ++i) {
+				buffer[i * length + word_i] = word[i];
+			}
+		}
+		FlagDirtyWords(MatrixView(word_length, length, buffer), 0, length,
+				flags);
+		AddDirtyWords(flags, word_begin, length, dirty_words);
+	}
+	AddCall(CodingStatistics::kVerify, number_words, start_time);
+	return kSuccess;
+}
+
+int HammingCoder::CorrectErasures(Matrix::Value *data, size_t number_words,
+		const uint8_t *erasures) const {
+	uint64_t start_time = GetStartTime();
+	size_t word_length = GetWordLength();
+	int ret = kSuccess;
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		Matrix::Value *word = data + word_i * word_length;
+		const uint8_t *word_erasures = erasures + word_i * word_length;
+		uint32_t positions[2];
+		size_t number_erasures = 0;
+		for (size_t i = 0; i < word_length; ++i) {
+			if (word_erasures[i] != 0) {
+				if (number_erasures < 2) {
+					positions[number_erasures] = i;
+				}
+				++number_erasures;
+			}
+		}
+		size_t syndrome_index = CalculateSyndromeIndex(word, 1);
+		if (number_erasures == 0) {
+			ret |= CorrectWord(syndrome_index, word, 1);
+		} else {
+			ret |= CorrectErasedWord(syndrome_index, positions,
+					number_erasures, word);
+		}
+	}
+	AddCall(CodingStatistics::kCorrect, number_words, start_time);
+	return ret;
+}
+
+int HammingCoder::SetEngine(Engine engine) {
+	if (engine != kMatrixEngine && engine != kTableEngine) {
+		return kInvalidArgument;
+	}
+	engine_ = engine;
+	return kSuccess;
+}
+
+int HammingCoder::SetStatistics(CodingStatistics *statistics) {
+	if (statistics != NULL
+			&& (statistics->GetWordLength() != GetWordLength()
+					|| statistics->GetAlphabetSize() != alphabet_size_)) {
+		return kInvalidArgument;
+	}
+	statistics_ = statistics;
+	return kSuccess;
+}
+
+uint64_t HammingCoder::GetStartTime() const {
+	return statistics_ == NULL ? 0 : statistics_->GetStartTime();
+}
+
+void HammingCoder::AddCall(CodingStatistics::Operation operation,
+		size_t number_words, uint64_t start_time) const {
+	if (statistics_ != NULL) {
+		statistics_->AddCall(operation, number_words, start_time);
+	}
+}
+
+MatrixView HammingCoder::GetInputView(const Matrix &matrix) {
+	return MatrixView(matrix.GetNumberRows(), matrix.GetNumberColums(),
+			const_cast<Matrix::Value *>(matrix.GetElements()));
+}
+
+int HammingCoder::MultiplyWords(const SparseMatrix &matrix,
+		const Matrix::Value *words, size_t number_words,
+		Matrix::Value *ret_words) const {
+	size_t number_rows = matrix.GetNumberRows();
+	size_t number_columns = matrix.GetNumberColums();
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		const Matrix::Value *word = words + word_i * number_columns;
+		Matrix::Value *ret_word = ret_words + word_i * number_rows;
+		for (size_t row_i = 0; row_i < number_rows; ++row_i) {
+			ret_word[row_i] = field_.Reduce(matrix.MultiplyRow(row_i, word, 1));
+		}
+	}
+	return 0;
+}
+
+int HammingCoder::BuildErrorTable(std::vector<Error> *error_table) {
+	size_t syndrome_length = checker_matrix_.GetNumberRows();
+	size_t word_length = checker_matrix_.GetNumberColums();
+	size_t table_size = 1;
+	for (size_t i = 0; i < syndrome_length; ++i) {
+		table_size *= alphabet_size_;
+	}
+	Error no_error;
+	memset(&no_error, 0, sizeof(no_error));
+	error_table->assign(table_size, no_error);
+	std::vector<Matrix::Value> syndrome(syndrome_length);
+	const Matrix::Value *checker_values = checker_matrix_.GetElements();
 	for (size_t i = 0; i < word_length; ++i) {
 		Error e;
+		memset(&e, 0, sizeof(e));
 		e.error_position = i;
-		for (Matrix::Value c = 0; c < alphabet_size_; ++c) {
-			word_values[i] = c;
-			Matrix::Multiply(checker_matrix_, word, &syndrome);
+		for (Matrix::Value c = 1; c < alphabet_size_; ++c) {
+			for (size_t row_i = 0; row_i < syndrome_length; ++row_i) {
+				syndrome[row_i] = field_.Multiply(
+						checker_values[row_i * word_length + i], c);
+			}
 			e.error_value = c;
-			error_table_.insert(std::make_pair(syndrome, e));
+			(*error_table)[GetSyndromeIndex(&syndrome[0], 1)] = e;
 		}
-		word_values[i] = 0;
 	}
+	(*error_table)[0] = no_error;
 	return 0;
 }
 
-int HammingCoder::MatrixModulo(Matrix &matrix, Matrix::Value n) {
-	size_t number_rows = matrix.GetNumberRows();
-	size_t number_columns = matrix.GetNumberColums();
-	Matrix::Value *values = matrix.GetElements();
-	for (size_t row_i = 0; row_i < number_rows; ++row_i) {
-		size_t offset = row_i * number_columns;
-		for (size_t column_i = 0; column_i < number_columns; ++column_i) {
-			values[offset + column_i] %= n;
+int HammingCoder::BuildLookupTable(const MatrixView &matrix,
+		ImageTable *table) {
+	size_t output_length = matrix.GetNumberRows();
+	size_t input_length = matrix.GetNumberColums();
+	const Matrix::Value *values = matrix.GetElements();
+	if (alphabet_size_ < 2 || input_length == 0) {
+		return 1;
+	}
+	bool packed = alphabet_size_ == 2 && output_length <= 64;
+	table->chunk_length = 1;
+	table->number_entries = alphabet_size_;
+	while (table->number_entries * alphabet_size_ <= 256) {
+		++table->chunk_length;
+		table->number_entries *= alphabet_size_;
+	}
+	table->output_length = output_length;
+	size_t number_chunks = (input_length + table->chunk_length - 1)
+			/ table->chunk_length;
+	size_t table_length = number_chunks * table->number_entries;
+	std::vector<uint64_t> masks(packed ? table_length : 0, 0);
+	std::vector<Matrix::Value> entries(packed ? 0 : table_length * output_length,
+			0);
+	std::vector<Matrix::Value> output(output_length);
+	for (size_t chunk_i = 0; chunk_i < number_chunks; ++chunk_i) {
+		size_t chunk_begin = chunk_i * table->chunk_length;
+		for (size_t entry_i = 0; entry_i < table->number_entries; ++entry_i) {
+			std::fill(output.begin(), output.end(), 0);
+			size_t rest = entry_i;
+			for (size_t i = chunk_begin;
+					i < chunk_begin + table->chunk_length && i < input_length;
+					++i) {
+				Matrix::Value symbol = rest % alphabet_size_;
+				rest /= alphabet_size_;
+				for (size_t row_i = 0; row_i < output_length; ++row_i) {
+					output[row_i] = field_.Add(output[row_i],
+							field_.Multiply(values[row_i * input_length + i],
+									symbol));
+				}
+			}
+			size_t table_i = chunk_i * table->number_entries + entry_i;
+			if (packed) {
+				for (size_t row_i = 0; row_i < output_length; ++row_i) {
+					masks[table_i] |= static_cast<uint64_t>(output[row_i])
+							<< row_i;
+				}
+			} else {
+				std::copy(output.begin(), output.end(),
+						entries.begin() + table_i * output_length);
+			}
+		}
+	}
+	table->number_masks = masks.size();
+	table->masks_offset = AppendSection(masks.empty() ? NULL : &masks[0],
+			masks.size() * sizeof(uint64_t));
+	table->entries_length = entries.size();
+	table->entries_offset = AppendSection(entries.empty() ? NULL : &entries[0],
+			entries.size());
+	return 0;
+}
+
+int HammingCoder::EncodeWordByTable(const Matrix::Value *data, size_t stride,
+		Matrix::Value *encoded_data, size_t encoded_stride) const {
+	const LookupTable &table = encode_table_;
+	size_t data_length = GetDataLength();
+	size_t word_length = table.output_length;
+	if (table.entries == NULL) {
+		uint64_t mask = 0;
+		const uint64_t *masks = table.masks;
+		for (size_t chunk_begin = 0; chunk_begin < data_length; chunk_begin +=
+				table.chunk_length, masks += table.number_entries) {
+			size_t chunk_end = std::min(chunk_begin + table.chunk_length,
+					data_length);
+			size_t entry_i = 0;
+			for (size_t i = chunk_end; i > chunk_begin; --i) {
+				entry_i = (entry_i << 1) | data[(i - 1) * stride];
+			}
+			mask ^= masks[entry_i];
+		}
+		for (size_t i = 0; i < word_length; ++i) {
+			encoded_data[i * encoded_stride] = (mask >> i) & 1;
+		}
+		return 0;
+	}
+	for (size_t i = 0; i < word_length; ++i) {
+		encoded_data[i * encoded_stride] = 0;
+	}
+	const Matrix::Value *entries = table.entries;
+	for (size_t chunk_begin = 0; chunk_begin < data_length; chunk_begin +=
+			table.chunk_length, entries += table.number_entries * word_length) {
+		size_t chunk_end = std::min(chunk_begin + table.chunk_length,
+				data_length);
+		size_t entry_i = 0;
+		for (size_t i = chunk_end; i > chunk_begin; --i) {
+			entry_i = entry_i * alphabet_size_ + data[(i - 1) * stride];
+		}
+		const Matrix::Value *entry = entries + entry_i * word_length;
+		for (size_t i = 0; i < word_length; ++i) {
+			Matrix::Value *value = encoded_data + i * encoded_stride;
+			*value = field_.Add(*value, entry[i]);
+		}
+	}
+	return 0;
+}
+
+// For binary codes the packed syndrome is the syndrome index itself.
+size_t HammingCoder::CalculateSyndromeIndexByTable(const Matrix::Value *word,
+		size_t stride) const {
+	const LookupTable &table = syndrome_table_;
+	size_t word_length = checker_matrix_.GetNumberColums();
+	size_t syndrome_length = table.output_length;
+	if (table.entries == NULL) {
+		uint64_t mask = 0;
+		const uint64_t *masks = table.masks;
+		for (size_t chunk_begin = 0; chunk_begin < word_length; chunk_begin +=
+				table.chunk_length, masks += table.number_entries) {
+			size_t chunk_end = std::min(chunk_begin + table.chunk_length,
+					word_length);
+			size_t entry_i = 0;
+			for (size_t i = chunk_end; i > chunk_begin; --i) {
+				entry_i = (entry_i << 1) | word[(i - 1) * stride];
+			}
+			mask ^= masks[entry_i];
 		}
+		return mask;
+	}
+	Matrix::Value syndrome[kMaxSyndromeLength];
+	std::fill(syndrome, syndrome + syndrome_length, 0);
+	const Matrix::Value *entries = table.entries;
+	for (size_t chunk_begin = 0; chunk_begin < word_length; chunk_begin +=
+			table.chunk_length, entries += table.number_entries
+			* syndrome_length) {
+		size_t chunk_end = std::min(chunk_begin + table.chunk_length,
+				word_length);
+		size_t entry_i = 0;
+		for (size_t i = chunk_end; i > chunk_begin; --i) {
+			entry_i = entry_i * alphabet_size_ + word[(i - 1) * stride];
+		}
+		const Matrix::Value *entry = entries + entry_i * syndrome_length;
+		for (size_t i = 0; i < syndrome_length; ++i) {
+			syndrome[i] = field_.Add(syndrome[i], entry[i]);
+		}
+	}
+	return GetSyndromeIndex(syndrome, 1);
+}
+
+int HammingCoder::BuildDataPositions(std::vector<uint32_t> *data_positions,
+		bool *systematic) {
+	size_t data_length = receiver_matrix_.GetNumberRows();
+	size_t word_length = receiver_matrix_.GetNumberColums();
+	const Matrix::Value *values = receiver_matrix_.GetElements();
+	data_positions->clear();
+	*systematic = false;
+	std::vector<uint32_t> positions(data_length);
+	for (size_t row_i = 0; row_i < data_length; ++row_i) {
+		size_t number_ones = 0;
+		for (size_t i = 0; i < word_length; ++i) {
+			Matrix::Value value = values[row_i * word_length + i];
+			if (value == 1) {
+				positions[row_i] = i;
+				++number_ones;
+			} else if (value != 0) {
+				return 0;
+			}
+		}
+		if (number_ones != 1) {
+			return 0;
+		}
+	}
+	data_positions->swap(positions);
+	*systematic = true;
+	for (size_t i = 0; i < data_length; ++i) {
+		if ((*data_positions)[i] != i) {
+			*systematic = false;
+		}
+	}
+	return 0;
+}
+
+size_t HammingCoder::GetSyndromeIndex(const Matrix::Value *syndrome,
+		size_t stride) const {
+	size_t index = 0;
+	for (size_t i = checker_matrix_.GetNumberRows(); i > 0; --i) {
+		index = index * alphabet_size_ + syndrome[(i - 1) * stride];
+	}
+	return index;
+}
+
+size_t HammingCoder::CalculateSyndromeIndex(const Matrix::Value *word,
+		size_t stride) const {
+	if (engine_ == kTableEngine) {
+		return CalculateSyndromeIndexByTable(word, stride);
+	}
+	size_t index = 0;
+	for (size_t row_i = sparse_checker_matrix_.GetNumberRows(); row_i > 0;
+			--row_i) {
+		index = index * alphabet_size_
+				+ field_.Reduce(
+						sparse_checker_matrix_.MultiplyRow(row_i - 1, word,
+								stride));
+	}
+	return index;
+}
+
+// ORs the syndrome symbols of each of the length words of data from
+// word_begin on into its flag. Binary syndromes are parities, which are
+// XORed 8 words at a time.
+void HammingCoder::FlagDirtyWords(const MatrixView &data, size_t word_begin,
+		size_t length, Matrix::Value *flags) const {
+	size_t syndrome_length = sparse_checker_matrix_.GetNumberRows();
+	int sums[kVerifyChunkLength];
+	Matrix::Value parities[kVerifyChunkLength];
+	std::fill(flags, flags + length, 0);
+	for (size_t row_i = 0; row_i < syndrome_length; ++row_i) {
+		if (alphabet_size_ == 2) {
+			sparse_checker_matrix_.MultiplyBinaryRow(row_i, data, word_begin,
+					length, parities);
+			for (size_t i = 0; i < length; ++i) {
+				flags[i] |= parities[i];
+			}
+		} else {
+			sparse_checker_matrix_.MultiplyRow(row_i, data, word_begin, length,
+					sums);
+			for (size_t i = 0; i < length; ++i) {
+				flags[i] |= field_.Reduce(sums[i]);
+			}
+		}
+	}
+}
+
+void HammingCoder::AddDirtyWords(const Matrix::Value *flags,
+		size_t word_begin, size_t length,
+		std::vector<size_t> *dirty_words) const {
+	Matrix::Value dirty = 0;
+	for (size_t i = 0; i < length; ++i) {
+		dirty |= flags[i];
+	}
+	if (dirty == 0) {
+		return;
+	}
+	for (size_t i = 0; i < length; ++i) {
+		if (flags[i] != 0) {
+			dirty_words->push_back(word_begin + i);
+		}
+	}
+}
+
+int HammingCoder::CorrectWord(size_t syndrome_index, Matrix::Value *word,
+		size_t stride) const {
+	if (syndrome_index == 0) {
+		return kSuccess;
+	}
+	const Error &e = error_table_[syndrome_index];
+	if (e.error_value == 0) {
+		if (statistics_ != NULL) {
+			statistics_->AddUncorrectableWord();
+		}
+		return kUncorrectableError;
+	}
+	if (statistics_ != NULL) {
+		statistics_->AddCorrectedWord();
+		statistics_->AddCorrectedSymbol(e.error_position, e.error_value);
+	}
+	Matrix::Value *error_value = word + e.error_position * stride;
+	*error_value = field_.Subtract(*error_value, e.error_value);
+	return kSuccess;
+}
+
+int HammingCoder::CorrectErasedWord(size_t syndrome_index,
+		const uint32_t *positions, size_t number_erasures,
+		Matrix::Value *word) const {
+	if (syndrome_index == 0) {
+		return kSuccess;
+	}
+	Matrix::Value values[2] = { 0, 0 };
+	if (number_erasures > 2
+			|| !SolveErasures(syndrome_index, positions, number_erasures,
+					values)) {
+		if (number_erasures == 1) {
+			return CorrectWord(syndrome_index, word, 1);
+		}
+		if (statistics_ != NULL) {
+			statistics_->AddUncorrectableWord();
+		}
+		return kUncorrectableError;
+	}
+	if (statistics_ != NULL) {
+		statistics_->AddCorrectedWord();
+	}
+	for (size_t i = 0; i < number_erasures; ++i) {
+		if (values[i] != 0) {
+			word[positions[i]] = field_.Subtract(word[positions[i]], values[i]);
+			if (statistics_ != NULL) {
+				statistics_->AddCorrectedSymbol(positions[i], values[i]);
+			}
+		}
+	}
+	return kSuccess;
+}
+
+// Finds error values e with s = sum e_i H[:, positions[i]]. The columns of
+// a Hamming checker matrix are pairwise independent, so two erasures have
+// at most one solution, found from two rows whose 2 x 2 minor is nonzero
+// and then checked against every row. Binary values are 0 or 1, so only
+// the sums of the column syndromes are compared.
+bool HammingCoder::SolveErasures(size_t syndrome_index,
+		const uint32_t *positions, size_t number_erasures,
+		Matrix::Value *values) const {
+	if (alphabet_size_ == 2) {
+		size_t column_syndrome0 = column_syndromes_[positions[0]];
+		if (syndrome_index == column_syndrome0) {
+			values[0] = 1;
+			return true;
+		}
+		if (number_erasures == 1) {
+			return false;
+		}
+		size_t column_syndrome1 = column_syndromes_[positions[1]];
+		if (syndrome_index == column_syndrome1
+				|| syndrome_index == (column_syndrome0 ^ column_syndrome1)) {
+			values[0] = syndrome_index != column_syndrome1;
+			values[1] = 1;
+			return true;
+		}
+		return false;
+	}
+	size_t syndrome_length = checker_matrix_.GetNumberRows();
+	Matrix::Value syndrome[kMaxSyndromeLength];
+	for (size_t i = 0; i < syndrome_length; ++i) {
+		syndrome[i] = syndrome_index % alphabet_size_;
+		syndrome_index /= alphabet_size_;
+	}
+	const MatrixView &h = checker_matrix_;
+	if (number_erasures == 1) {
+		for (size_t i = 0; i < syndrome_length; ++i) {
+			Matrix::Value h0 = h.GetElement(i, positions[0]);
+			if (h0 != 0) {
+				values[0] = field_.Multiply(syndrome[i], field_.Inverse(h0));
+				break;
+			}
+		}
+	} else {
+		bool solved = false;
+		for (size_t i = 0; i < syndrome_length && !solved; ++i) {
+			for (size_t j = i + 1; j < syndrome_length && !solved; ++j) {
+				Matrix::Value h0i = h.GetElement(i, positions[0]);
+				Matrix::Value h0j = h.GetElement(j, positions[0]);
+				Matrix::Value h1i = h.GetElement(i, positions[1]);
+				Matrix::Value h1j = h.GetElement(j, positions[1]);
+				Matrix::Value determinant = field_.Subtract(
+						field_.Multiply(h0i, h1j), field_.Multiply(h1i, h0j));
+				if (determinant == 0) {
+					continue;
+				}
+				Matrix::Value inverse = field_.Inverse(determinant);
+				values[0] = field_.Multiply(inverse,
+						field_.Subtract(field_.Multiply(syndrome[i], h1j),
+								field_.Multiply(syndrome[j], h1i)));
+				values[1] = field_.Multiply(inverse,
+						field_.Subtract(field_.Multiply(h0i, syndrome[j]),
+								field_.Multiply(h0j, syndrome[i])));
+				solved = true;
+			}
+		}
+	}
+	for (size_t i = 0; i < syndrome_length; ++i) {
+		Matrix::Value value = 0;
+		for (size_t k = 0; k < number_erasures; ++k) {
+			value = field_.Add(value,
+					field_.Multiply(values[k], h.GetElement(i, positions[k])));
+		}
+		if (value != syndrome[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// R (c - e) = R c - e R[:, error_position], so only the data symbols whose
+// receiver row reads the erroneous position change.
+int HammingCoder::CorrectDecodedWord(size_t syndrome_index,
+		Matrix::Value *data, size_t stride) const {
+	if (syndrome_index == 0) {
+		return kSuccess;
+	}
+	const Error &e = error_table_[syndrome_index];
+	if (e.error_value == 0) {
+		if (statistics_ != NULL) {
+			statistics_->AddUncorrectableWord();
+		}
+		return kUncorrectableError;
+	}
+	if (statistics_ != NULL) {
+		statistics_->AddCorrectedWord();
+		statistics_->AddCorrectedSymbol(e.error_position, e.error_value);
+	}
+	size_t data_length = receiver_matrix_.GetNumberRows();
+	size_t word_length = receiver_matrix_.GetNumberColums();
+	const Matrix::Value *receiver_values = receiver_matrix_.GetElements()
+			+ e.error_position;
+	for (size_t i = 0; i < data_length; ++i) {
+		Matrix::Value r = receiver_values[i * word_length];
+		if (r != 0) {
+			Matrix::Value *value = data + i * stride;
+			*value = field_.Subtract(*value, field_.Multiply(r, e.error_value));
+		}
+	}
+	return kSuccess;
+}
+
+// Builds the image from the matrix views, which point at the normalized
+// matrices of the constructor until the image is attached.
+int HammingCoder::BuildImage() {
+	ImageHeader header;
+	memset(&header, 0, sizeof(header));
+	image_.assign(sizeof(header) / sizeof(uint64_t), 0);
+	memcpy(header.magic, kImageMagic, sizeof(header.magic));
+	header.alphabet_size = alphabet_size_;
+	header.word_length = generator_matrix_.GetNumberRows();
+	header.data_length = generator_matrix_.GetNumberColums();
+	header.syndrome_length = checker_matrix_.GetNumberRows();
+	header.receiver_length = receiver_matrix_.GetNumberRows();
+	header.generator_offset = AppendSection(generator_matrix_.GetElements(),
+			header.word_length * header.data_length);
+	header.checker_offset = AppendSection(checker_matrix_.GetElements(),
+			header.syndrome_length * header.word_length);
+	header.receiver_offset = AppendSection(receiver_matrix_.GetElements(),
+			header.receiver_length * header.word_length);
+	std::vector<Error> error_table;
+	BuildErrorTable(&error_table);
+	header.error_table_length = error_table.size();
+	header.error_table_offset = AppendSection(&error_table[0],
+			error_table.size() * sizeof(Error));
+	std::vector<uint32_t> data_positions;
+	bool systematic = false;
+	BuildDataPositions(&data_positions, &systematic);
+	header.number_data_positions = data_positions.size();
+	header.data_positions_offset = AppendSection(
+			data_positions.empty() ? NULL : &data_positions[0],
+			data_positions.size() * sizeof(uint32_t));
+	header.systematic = systematic;
+	BuildLookupTable(generator_matrix_, &header.encode_table);
+	BuildLookupTable(checker_matrix_, &header.syndrome_table);
+	header.image_length = image_.size() * sizeof(uint64_t);
+	memcpy(&image_[0], &header, sizeof(header));
+	return AttachImage(&image_[0]);
+}
+
+size_t HammingCoder::AppendSection(const void *data, size_t length) {
+	size_t offset = image_.size() * sizeof(uint64_t);
+	image_.resize(image_.size()
+			+ (length + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+	if (length > 0) {
+		memcpy(reinterpret_cast<char *>(&image_[0]) + offset, data, length);
+	}
+	return offset;
+}
+
+// The image is never written through the views; the casts only drop const.
+int HammingCoder::AttachImage(const uint64_t *image) {
+	const ImageHeader &header = *reinterpret_cast<const ImageHeader *>(image);
+	const char *base = reinterpret_cast<const char *>(image);
+	alphabet_size_ = header.alphabet_size;
+	field_ = GaloisField(alphabet_size_);
+	generator_matrix_ = MatrixView(header.word_length, header.data_length,
+			const_cast<Matrix::Value *>(base + header.generator_offset));
+	checker_matrix_ = MatrixView(header.syndrome_length, header.word_length,
+			const_cast<Matrix::Value *>(base + header.checker_offset));
+	receiver_matrix_ = MatrixView(header.receiver_length, header.word_length,
+			const_cast<Matrix::Value *>(base + header.receiver_offset));
+	error_table_ = reinterpret_cast<const Error *>(base
+			+ header.error_table_offset);
+	number_data_positions_ = header.number_data_positions;
+	data_positions_ =
+			number_data_positions_ == 0 ?
+					NULL :
+					reinterpret_cast<const uint32_t *>(base
+							+ header.data_positions_offset);
+	systematic_ = header.systematic != 0;
+	sparse_generator_matrix_.Assign(generator_matrix_);
+	sparse_checker_matrix_.Assign(checker_matrix_);
+	sparse_receiver_matrix_.Assign(receiver_matrix_);
+	column_syndromes_.resize(header.word_length);
+	for (size_t i = 0; i < column_syndromes_.size(); ++i) {
+		column_syndromes_[i] = GetSyndromeIndex(
+				checker_matrix_.GetElements() + i, header.word_length);
+	}
+	const ImageTable *image_tables[] = { &header.encode_table,
+			&header.syndrome_table };
+	LookupTable *tables[] = { &encode_table_, &syndrome_table_ };
+	for (size_t i = 0; i < 2; ++i) {
+		const ImageTable &image_table = *image_tables[i];
+		LookupTable *table = tables[i];
+		table->chunk_length = image_table.chunk_length;
+		table->number_entries = image_table.number_entries;
+		table->output_length = image_table.output_length;
+		table->masks =
+				image_table.number_masks == 0 ?
+						NULL :
+						reinterpret_cast<const uint64_t *>(base
+								+ image_table.masks_offset);
+		table->entries =
+				image_table.entries_length == 0 ?
+						NULL :
+						reinterpret_cast<const Matrix::Value *>(base
+								+ image_table.entries_offset);
+	}
+	return 0;
+}
+
+int HammingCoder::ReleaseImage() {
+	if (mapped_image_ != NULL) {
+		munmap(const_cast<uint64_t *>(mapped_image_), mapped_length_);
+		mapped_image_ = NULL;
+		mapped_length_ = 0;
+	}
+	image_.clear();
+	generator_matrix_ = MatrixView();
+	checker_matrix_ = MatrixView();
+	receiver_matrix_ = MatrixView();
+	error_table_ = NULL;
+	data_positions_ = NULL;
+	number_data_positions_ = 0;
+	systematic_ = false;
+	encode_table_ = LookupTable();
+	syndrome_table_ = LookupTable();
+	return 0;
+}
+
+const uint64_t* HammingCoder::GetImage() const {
+	if (mapped_image_ != NULL) {
+		return mapped_image_;
+	}
+	return image_.empty() ? NULL : &image_[0];
+}
+
+bool HammingCoder::IsInImage(size_t length, uint64_t offset, uint64_t size) {
+	return offset % sizeof(uint64_t) == 0 && offset >= sizeof(ImageHeader)
+			&& offset <= length && size <= length - offset;
+}
+
+// Checks everything the coding functions index with, so a corrupt file
+// cannot make them read or write out of bounds.
+int HammingCoder::ValidateImage(const uint64_t *image, size_t length) {
+	if (length < sizeof(ImageHeader) || length % sizeof(uint64_t) != 0) {
+		return kInvalidArgument;
+	}
+	const ImageHeader &header = *reinterpret_cast<const ImageHeader *>(image);
+	const char *base = reinterpret_cast<const char *>(image);
+	uint64_t q = header.alphabet_size;
+	uint64_t n = header.word_length;
+	uint64_t k = header.data_length;
+	uint64_t r = header.syndrome_length;
+	uint64_t receiver_length = header.receiver_length;
+	if (memcmp(header.magic, kImageMagic, sizeof(header.magic)) != 0
+			|| header.image_length != length || !GaloisField::IsPrime(q) || q > 127 || n == 0
+			|| n > kMaxImageWordLength || k == 0 || k > n || r == 0
+			|| r > kMaxSyndromeLength || receiver_length != k) {
+		return kInvalidArgument;
+	}
+	uint64_t error_table_length = 1;
+	for (uint64_t i = 0; i < r; ++i) {
+		error_table_length *= q;
+		if (error_table_length > length) {
+			return kInvalidArgument;
+		}
+	}
+	if (!IsInImage(length, header.generator_offset, n * k)
+			|| !IsInImage(length, header.checker_offset, r * n)
+			|| !IsInImage(length, header.receiver_offset, receiver_length * n)
+			|| header.error_table_length != error_table_length
+			|| !IsInImage(length, header.error_table_offset,
+					error_table_length * sizeof(Error))
+			|| (header.number_data_positions != 0
+					&& header.number_data_positions != receiver_length)
+			|| !IsInImage(length, header.data_positions_offset,
+					header.number_data_positions * sizeof(uint32_t))) {
+		return kInvalidArgument;
+	}
+	const uint64_t matrix_offsets[] = { header.generator_offset,
+			header.checker_offset, header.receiver_offset };
+	const uint64_t matrix_lengths[] = { n * k, r * n, receiver_length * n };
+	for (size_t i = 0; i < 3; ++i) {
+		const Matrix::Value *values = base + matrix_offsets[i];
+		for (uint64_t j = 0; j < matrix_lengths[i]; ++j) {
+			if (values[j] < 0 || static_cast<uint64_t>(values[j]) >= q) {
+				return kInvalidArgument;
+			}
+		}
+	}
+	const Error *error_table = reinterpret_cast<const Error *>(base
+			+ header.error_table_offset);
+	for (uint64_t i = 0; i < error_table_length; ++i) {
+		if (error_table[i].error_position >= n || error_table[i].error_value < 0
+				|| static_cast<uint64_t>(error_table[i].error_value) >= q) {
+			return kInvalidArgument;
+		}
+	}
+	// Decode copies the symbols at the data positions, so they must be the
+	// ones the receiver matrix selects, and systematic must be set exactly
+	// when they are the first k symbols.
+	const uint32_t *data_positions = reinterpret_cast<const uint32_t *>(base
+			+ header.data_positions_offset);
+	const Matrix::Value *receiver = base + header.receiver_offset;
+	bool systematic = header.number_data_positions != 0;
+	for (uint64_t i = 0; i < header.number_data_positions; ++i) {
+		if (data_positions[i] >= n) {
+			return kInvalidArgument;
+		}
+		for (uint64_t j = 0; j < n; ++j) {
+			if (receiver[i * n + j] != (j == data_positions[i] ? 1 : 0)) {
+				return kInvalidArgument;
+			}
+		}
+		systematic = systematic && data_positions[i] == i;
+	}
+	if (header.systematic != static_cast<uint64_t>(systematic)) {
+		return kInvalidArgument;
+	}
+	if (ValidateTable(image, length, header.encode_table, q, k, n) != kSuccess
+			|| ValidateTable(image, length, header.syndrome_table, q, n, r)
+					!= kSuccess) {
+		return kInvalidArgument;
+	}
+	return kSuccess;
+}
+
+int HammingCoder::ValidateTable(const uint64_t *image, size_t length,
+		const ImageTable &table, uint64_t alphabet_size, uint64_t input_length,
+		uint64_t output_length) {
+	if (table.output_length != output_length || table.chunk_length == 0
+			|| table.chunk_length > 8) {
+		return kInvalidArgument;
+	}
+	uint64_t number_entries = 1;
+	for (uint64_t i = 0; i < table.chunk_length; ++i) {
+		number_entries *= alphabet_size;
+	}
+	uint64_t table_length = (input_length + table.chunk_length - 1)
+			/ table.chunk_length * number_entries;
+	if (table.number_entries != number_entries || table_length > length) {
+		return kInvalidArgument;
+	}
+	if (alphabet_size == 2 && output_length <= 64) {
+		if (table.number_masks != table_length || table.entries_length != 0
+				|| !IsInImage(length, table.masks_offset,
+						table_length * sizeof(uint64_t))) {
+			return kInvalidArgument;
+		}
+		// Packed syndromes index the error table directly.
+		const uint64_t *masks = image + table.masks_offset / sizeof(uint64_t);
+		for (uint64_t i = 0; i < table_length; ++i) {
+			if (output_length < 64 && (masks[i] >> output_length) != 0) {
+				return kInvalidArgument;
+			}
+		}
+		return kSuccess;
+	}
+	if (table.number_masks != 0
+			|| table.entries_length != table_length * output_length
+			|| !IsInImage(length, table.entries_offset, table.entries_length)) {
+		return kInvalidArgument;
+	}
+	const Matrix::Value *entries = reinterpret_cast<const char *>(image)
+			+ table.entries_offset;
+	for (uint64_t i = 0; i < table.entries_length; ++i) {
+		if (entries[i] < 0 || static_cast<uint64_t>(entries[i]) >= alphabet_size) {
+			return kInvalidArgument;
+		}
+	}
+	return kSuccess;
+}
+
+int HammingCoder::NormalizeMatrix(Matrix *matrix) {
+	Matrix::Value *values = matrix->GetElements();
+	size_t length = matrix->GetNumberRows() * matrix->GetNumberColums();
+	for (size_t i = 0; i < length; ++i) {
+		values[i] = field_.Normalize(values[i]);
 	}
 	return 0;
 }
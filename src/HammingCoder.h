@@ -36,80 +36,273 @@
 #define HAMMINGCODER_H_
 
 #include <stdint.h>
-#include <tr1/unordered_map>
+#include <vector>
+#include "CodingStatistics.h"
+#include "GaloisField.h"
 #include "Matrix.h"
+#include "MatrixArena.h"
+#include "MatrixView.h"
+#include "SparseMatrix.h"
 
 namespace hamming_code {
 
+/*
+ * Single-error-correcting Hamming coder over GF(q).
+ *
+ * The coding functions are const and keep no state between calls: their
+ * only scratch memory is the stack or a MatrixArena passed by the caller.
+ * One coder can therefore be shared by any number of threads without locks,
+ * each thread bringing its own arena. SetEngine, SetStatistics, assignment
+ * and Load modify the coder and must not overlap with other calls.
+ */
 class HammingCoder {
 public:
+	// kTableEngine encodes and computes syndromes from tables that hold the
+	// contribution of every value of a chunk of symbols, 8 symbols per
+	// chunk for binary codes. Both engines give the same results.
+	enum Engine {
+		kMatrixEngine, kTableEngine
+	};
+
 	HammingCoder();
+	// The alphabet size must be prime.
 	HammingCoder(uint8_t alphabet_size, Matrix &generator_matrix,
 			Matrix &checker_matrix, Matrix &receiver_matrix);
+	// A copy owns its image, also when the original is mapped.
+	HammingCoder(const HammingCoder &coder);
+	HammingCoder &operator=(const HammingCoder &coder);
 
 	virtual ~HammingCoder();
 
-	int Encode(Matrix &data, Matrix *encoded_data);
-	int Correct(Matrix &data, Matrix *corrected_data);
-	int Decode(Matrix &encoded_data, Matrix *data);
+	// Writes the matrices and every precomputed table to path. Load maps
+	// such a file read-only and uses it in place without rebuilding, so
+	// processes loading the same file share its pages. Files are validated
+	// on load and are only portable between machines of the same byte
+	// order. Both return kIoError if the file cannot be written or mapped.
+	int Save(const char *path) const;
+	static int Load(const char *path, HammingCoder *coder);
+
+	// Each column of a matrix is one word, so a k x N data matrix is coded
+	// by a single matrix-matrix product. Correct returns kUncorrectableError
+	// if the syndrome of any word matches no single error. Symbols are in
+	// [0, alphabet_size); all arithmetic is done in GF(alphabet_size).
+	int Encode(const Matrix &data, Matrix *encoded_data) const;
+	int Correct(const Matrix &data, Matrix *corrected_data) const;
+	int Decode(const Matrix &encoded_data, Matrix *data) const;
+
+	// Same as above over caller-owned storage; nothing is allocated and the
+	// output views must already have the right shape. Correct may alias its
+	// input and output. With an arena, the syndromes are computed by one
+	// matrix product into arena memory instead of word by word.
+	int Encode(const MatrixView &data, MatrixView *encoded_data) const;
+	int Correct(const MatrixView &data, MatrixView *corrected_data,
+			MatrixArena *arena = NULL) const;
+	int Decode(const MatrixView &encoded_data, MatrixView *data) const;
+
+	// Words are laid out contiguously, one symbol per value.
+	int Encode(const Matrix::Value *data, size_t number_words,
+			Matrix::Value *encoded_data) const;
+	int Correct(const Matrix::Value *data, size_t number_words,
+			Matrix::Value *corrected_data) const;
+	int Decode(const Matrix::Value *encoded_data, size_t number_words,
+			Matrix::Value *data) const;
+
+	// Correct in the caller's buffer: clean words are only read, a bad word
+	// has its one erroneous symbol rewritten.
+	int Correct(MatrixView *data) const;
+	int Correct(Matrix::Value *data, size_t number_words) const;
+
+	// Decode and then fix the decoded symbols that depend on the erroneous
+	// one, so the codeword is neither copied nor written.
+	int CorrectAndDecode(const MatrixView &encoded_data,
+			MatrixView *data) const;
+	int CorrectAndDecode(const Matrix::Value *encoded_data,
+			size_t number_words, Matrix::Value *data) const;
+
+	// Only detect errors: dirty_words is cleared and gets the index of every
+	// word with a nonzero syndrome, in order. Nothing is copied or written,
+	// so the few dirty words can be corrected afterwards. The words count
+	// as verified words.
+	int Verify(const Matrix &data, std::vector<size_t> *dirty_words) const;
+	int Verify(const MatrixView &data, std::vector<size_t> *dirty_words) const;
+	int Verify(const Matrix::Value *data, size_t number_words,
+			std::vector<size_t> *dirty_words) const;
+
+	// Correct words whose unreliable symbols are known: a nonzero byte of
+	// erasures, laid out like data, marks an erased symbol. The values of up
+	// to two erased symbols of a word are solved for from its syndrome; a
+	// word with one erasure whose syndrome does not fit it, or with none,
+	// gets single error correction. Returns kUncorrectableError for words
+	// with a nonzero syndrome that fits none of these, which are left as
+	// they were. Words with a zero syndrome are accepted as they are.
+	int CorrectErasures(Matrix::Value *data, size_t number_words,
+			const uint8_t *erasures) const;
+
+	int SetEngine(Engine engine);
+
+	Engine GetEngine() const {
+		return engine_;
+	}
+
+	// Counts the words of every coding call, and the corrected and
+	// uncorrectable words, into statistics, which must match the word length
+	// and alphabet size of the coder and outlive its use. NULL, the
+	// default, turns counting off. Copies count into the same statistics;
+	// Load turns counting off.
+	int SetStatistics(CodingStatistics *statistics);
+
+	CodingStatistics *GetStatistics() const {
+		return statistics_;
+	}
+
+	size_t GetWordLength() const {
+		return generator_matrix_.GetNumberRows();
+	}
+
+	size_t GetDataLength() const {
+		return generator_matrix_.GetNumberColums();
+	}
+
+	// The state of a coder is one image: this header followed by 8-byte
+	// aligned sections at the given byte offsets. Save writes the image as
+	// it is and Load maps it. Public so tools and tests can inspect files.
+	struct ImageTable {
+		uint64_t chunk_length;
+		uint64_t number_entries;
+		uint64_t output_length;
+		uint64_t number_masks;
+		uint64_t masks_offset;
+		uint64_t entries_length;
+		uint64_t entries_offset;
+	};
+	struct ImageHeader {
+		char magic[8];
+		uint64_t image_length;
+		uint64_t alphabet_size;
+		uint64_t word_length;
+		uint64_t data_length;
+		uint64_t syndrome_length;
+		uint64_t receiver_length;
+		uint64_t generator_offset;
+		uint64_t checker_offset;
+		uint64_t receiver_offset;
+		uint64_t error_table_length;
+		uint64_t error_table_offset;
+		uint64_t number_data_positions;
+		uint64_t data_positions_offset;
+		uint64_t systematic;
+		ImageTable encode_table;
+		ImageTable syndrome_table;
+	};
 
 private:
-	typedef Matrix Syndrome;
 	struct Error {
-		size_t error_position;
+		uint32_t error_position;
 		Matrix::Value error_value;
 	};
 
-	struct SyndromeEqual {
-		bool operator()(const Syndrome& syndrome0,
-				const Syndrome& syndrome1) const {
-			size_t number_colums = syndrome0.GetNumberColums();
-			size_t number_rows = syndrome0.GetNumberRows();
-			if (number_colums == syndrome1.GetNumberColums()
-					&& number_rows == syndrome1.GetNumberRows()) {
-				size_t length = number_colums * number_rows;
-				const Syndrome::Value *syndrome0_values =
-						syndrome0.GetElements();
-				const Syndrome::Value *syndrome1_values =
-						syndrome1.GetElements();
-				for (size_t i = 0; i < length; ++i) {
-					if (syndrome0_values[i] != syndrome1_values[i]) {
-						return false;
-					}
-				}
-			} else {
-				return false;
-			}
-			return true;
+	// Contributions of the symbol chunks of an input to matrix * input. A
+	// chunk of chunk_length symbols indexes its number_entries entries as a
+	// number in base alphabet_size_, first symbol least significant. Binary
+	// outputs of at most 64 symbols are packed into masks, bit i = symbol i;
+	// other outputs are stored as output_length values each.
+	struct LookupTable {
+		LookupTable() :
+				chunk_length(0), number_entries(0), output_length(0), masks(
+						NULL), entries(NULL) {
 		}
-	};
 
-	struct SyndromeHashFunction {
-		size_t operator()(const Syndrome& syndrome0) const {
-			size_t v = 0;
-			size_t number_colums = syndrome0.GetNumberColums();
-			size_t number_rows = syndrome0.GetNumberRows();
-			size_t length = number_colums * number_rows;
-			std::tr1::hash<Syndrome::Value> hash_func;
-			const Syndrome::Value *syndrome0_values = syndrome0.GetElements();
-			for (size_t i = 0; i < length; ++i) {
-				v ^= hash_func(syndrome0_values[i]);
-			}
-			return v;
-		}
+		size_t chunk_length;
+		size_t number_entries;
+		size_t output_length;
+		const uint64_t *masks;
+		const Matrix::Value *entries;
 	};
 
-	int BuildErrorTable();
-	int MatrixModulo(Matrix &matrix, Matrix::Value n);
+	static const char kImageMagic[8];
+	static const size_t kMaxSyndromeLength = 64;
+	static const size_t kMaxImageWordLength = 1 << 24;
+	// Words whose syndromes Verify computes together on the stack.
+	static const size_t kVerifyChunkLength = 256;
+	// Symbols of contiguous words Verify transposes at a time.
+	static const size_t kVerifyBufferLength = 16384;
+
+	static int ValidateImage(const uint64_t *image, size_t length);
+	static int ValidateTable(const uint64_t *image, size_t length,
+			const ImageTable &table, uint64_t alphabet_size,
+			uint64_t input_length, uint64_t output_length);
+	static bool IsInImage(size_t length, uint64_t offset, uint64_t size);
+
+	// Views of input matrices, which are only read.
+	static MatrixView GetInputView(const Matrix &matrix);
+
+	int MultiplyWords(const SparseMatrix &matrix, const Matrix::Value *words,
+			size_t number_words, Matrix::Value *ret_words) const;
 
-	typedef std::tr1::unordered_map<Syndrome, Error, SyndromeHashFunction,
-			SyndromeEqual> ErrorTable;
+	int BuildImage();
+	size_t AppendSection(const void *data, size_t length);
+	int AttachImage(const uint64_t *image);
+	int ReleaseImage();
+	const uint64_t* GetImage() const;
+	int BuildErrorTable(std::vector<Error> *error_table);
+	int BuildLookupTable(const MatrixView &matrix, ImageTable *table);
+	int EncodeWordByTable(const Matrix::Value *data, size_t stride,
+			Matrix::Value *encoded_data, size_t encoded_stride) const;
+	size_t CalculateSyndromeIndexByTable(const Matrix::Value *word,
+			size_t stride) const;
+	int BuildDataPositions(std::vector<uint32_t> *data_positions,
+			bool *systematic);
+	size_t GetSyndromeIndex(const Matrix::Value *syndrome,
+			size_t stride) const;
+	size_t CalculateSyndromeIndex(const Matrix::Value *word,
+			size_t stride) const;
+	void FlagDirtyWords(const MatrixView &data, size_t word_begin,
+			size_t length, Matrix::Value *flags) const;
+	void AddDirtyWords(const Matrix::Value *flags, size_t word_begin,
+			size_t length, std::vector<size_t> *dirty_words) const;
+	int CorrectWord(size_t syndrome_index, Matrix::Value *word,
+			size_t stride) const;
+	int CorrectErasedWord(size_t syndrome_index, const uint32_t *positions,
+			size_t number_erasures, Matrix::Value *word) const;
+	bool SolveErasures(size_t syndrome_index, const uint32_t *positions,
+			size_t number_erasures, Matrix::Value *values) const;
+	int CorrectDecodedWord(size_t syndrome_index, Matrix::Value *data,
+			size_t stride) const;
+	int NormalizeMatrix(Matrix *matrix);
+	uint64_t GetStartTime() const;
+	void AddCall(CodingStatistics::Operation operation, size_t number_words,
+			uint64_t start_time) const;
 
 	Matrix::Value alphabet_size_;
-	Matrix generator_matrix_;
-	Matrix checker_matrix_;
-	Matrix receiver_matrix_;
-	ErrorTable error_table_;
+	GaloisField field_;
+	Engine engine_;
+	// Everything below points into the image, which is either image_ or a
+	// read-only mapping of mapped_length_ bytes.
+	std::vector<uint64_t> image_;
+	const uint64_t *mapped_image_;
+	size_t mapped_length_;
+	CodingStatistics *statistics_;
+	MatrixView generator_matrix_;
+	MatrixView checker_matrix_;
+	MatrixView receiver_matrix_;
+	// Indexed by the syndrome read as a number in base alphabet_size_.
+	// Syndromes of no single error keep an error_value of 0.
+	const Error *error_table_;
+	// Set when every row of the receiver matrix selects one symbol, so
+	// decoding copies those symbols instead of multiplying.
+	const uint32_t *data_positions_;
+	size_t number_data_positions_;
+	bool systematic_;
+	LookupTable encode_table_;
+	LookupTable syndrome_table_;
+	// The matrix engine multiplies by sparse copies of the matrices, which
+	// are built on attach rather than stored in the image.
+	SparseMatrix sparse_generator_matrix_;
+	SparseMatrix sparse_checker_matrix_;
+	SparseMatrix sparse_receiver_matrix_;
+	// Syndrome index of a unit error at each position, so binary erasures
+	// are solved by comparing indices.
+	std::vector<size_t> column_syndromes_;
 
 };
 
@@ -0,0 +1,142 @@
+/*
+ * HammingStreamCoder.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "HammingStreamCoder.h"
+#include "Status.h"
+#include <assert.h>
+
+namespace hamming_code {
+
+HammingStreamCoder::HammingStreamCoder(BinaryHammingCoder *coder, Mode mode) :
+		coder_(coder), mode_(mode), input_word_length_(
+				mode == kEncode ?
+						coder->GetDataLength() : coder->GetWordLength()), output_word_length_(
+				mode == kEncode ?
+						coder->GetWordLength() : coder->GetDataLength()), input_mask_(
+				0), input_bits_(0), number_input_bits_(0), output_bits_(0), number_output_bits_(
+				0) {
+	assert(input_word_length_ > 0);
+	input_mask_ = ~static_cast<BinaryHammingCoder::Word>(0)
+			>> (BinaryHammingCoder::kMaxWordLength - input_word_length_);
+}
+
+HammingStreamCoder::~HammingStreamCoder() {
+
+}
+
+size_t HammingStreamCoder::GetMaxOutputLength(size_t length) const {
+	size_t number_words = (number_input_bits_ + length * 8)
+			/ input_word_length_ + 1;
+	return (number_output_bits_ + number_words * output_word_length_ + 7) / 8;
+}
+
+int HammingStreamCoder::Process(const uint8_t *input, size_t length,
+		uint8_t *output, size_t *output_length) {
+	if (*output_length < GetMaxOutputLength(length)) {
+		return 1;
+	}
+	uint8_t *output_end = output;
+	int ret = kSuccess;
+	for (size_t i = 0; i < length; ++i) {
+		input_bits_ |= static_cast<BitBuffer>(input[i]) << number_input_bits_;
+		number_input_bits_ += 8;
+		while (number_input_bits_ >= input_word_length_) {
+			BinaryHammingCoder::Word word =
+					static_cast<BinaryHammingCoder::Word>(input_bits_)
+							& input_mask_;
+			input_bits_ >>= input_word_length_;
+			number_input_bits_ -= input_word_length_;
+			BinaryHammingCoder::Word transformed_word = 0;
+			ret |= Transform(word, &transformed_word);
+			PushWord(transformed_word, &output_end);
+		}
+	}
+	*output_length = output_end - output;
+	return ret;
+}
+
+int HammingStreamCoder::Finish(uint8_t *output, size_t *output_length) {
+	if (*output_length < GetMaxOutputLength(0)) {
+		return 1;
+	}
+	uint8_t *output_end = output;
+	int ret = kSuccess;
+	if (mode_ == kEncode && number_input_bits_ > 0) {
+		BinaryHammingCoder::Word transformed_word = 0;
+		ret |= Transform(
+				static_cast<BinaryHammingCoder::Word>(input_bits_)
+						& input_mask_, &transformed_word);
+		PushWord(transformed_word, &output_end);
+	}
+	if (number_output_bits_ > 0) {
+		*output_end = static_cast<uint8_t>(output_bits_);
+		++output_end;
+	}
+	*output_length = output_end - output;
+	return ret | Reset();
+}
+
+int HammingStreamCoder::Reset() {
+	input_bits_ = 0;
+	number_input_bits_ = 0;
+	output_bits_ = 0;
+	number_output_bits_ = 0;
+	return 0;
+}
+
+int HammingStreamCoder::Transform(BinaryHammingCoder::Word word,
+		BinaryHammingCoder::Word *ret_word) {
+	if (mode_ == kEncode) {
+		return coder_->Encode(word, ret_word);
+	}
+	int ret = coder_->Correct(word, &word);
+	coder_->Decode(word, ret_word);
+	return ret;
+}
+
+void HammingStreamCoder::PushWord(BinaryHammingCoder::Word word,
+		uint8_t **output) {
+	output_bits_ |= static_cast<BitBuffer>(word) << number_output_bits_;
+	number_output_bits_ += output_word_length_;
+	uint8_t *output_end = *output;
+	while (number_output_bits_ >= 8) {
+		*output_end = static_cast<uint8_t>(output_bits_);
+		++output_end;
+		output_bits_ >>= 8;
+		number_output_bits_ -= 8;
+	}
+	*output = output_end;
+}
+
+} /* namespace hamming_code */
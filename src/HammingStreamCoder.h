@@ -0,0 +1,98 @@
+/*
+ * HammingStreamCoder.h
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HAMMINGSTREAMCODER_H_
+#define HAMMINGSTREAMCODER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "BinaryHammingCoder.h"
+
+namespace hamming_code {
+
+/*
+ * Streams bytes through a BinaryHammingCoder.
+ *
+ * Bytes are read as a bit stream, least significant bit first. In kEncode
+ * mode the stream is cut into data words and the code words are written
+ * back to back into the output bytes. In kDecode mode code words are read,
+ * corrected and decoded, and the data words are written back to back. Input
+ * may be split across any number of Process calls; Finish pads the last data
+ * word and the last output byte with zeros. The decoder cannot tell padding
+ * from data, so callers keep the original length themselves.
+ */
+class HammingStreamCoder {
+public:
+	enum Mode {
+		kEncode, kDecode
+	};
+
+	HammingStreamCoder(BinaryHammingCoder *coder, Mode mode);
+
+	virtual ~HammingStreamCoder();
+
+	// Upper bound of the bytes written by Process(length bytes) and a
+	// following Finish.
+	size_t GetMaxOutputLength(size_t length) const;
+
+	// *output_length is the capacity of output on input and the number of
+	// bytes written on return. Returns 1 if the capacity is too small for
+	// GetMaxOutputLength(length). A decoder returns kUncorrectableError if
+	// any code word could not be corrected; its data word is decoded as
+	// received.
+	int Process(const uint8_t *input, size_t length, uint8_t *output,
+			size_t *output_length);
+	int Finish(uint8_t *output, size_t *output_length);
+	int Reset();
+
+private:
+	__extension__ typedef unsigned __int128 BitBuffer;
+
+	int Transform(BinaryHammingCoder::Word word,
+			BinaryHammingCoder::Word *ret_word);
+	void PushWord(BinaryHammingCoder::Word word, uint8_t **output);
+
+	BinaryHammingCoder *coder_;
+	Mode mode_;
+	size_t input_word_length_;
+	size_t output_word_length_;
+	BinaryHammingCoder::Word input_mask_;
+	BitBuffer input_bits_;
+	size_t number_input_bits_;
+	BitBuffer output_bits_;
+	size_t number_output_bits_;
+};
+
+} /* namespace hamming_code */
+#endif /* HAMMINGSTREAMCODER_H_ */
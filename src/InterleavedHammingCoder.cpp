@@ -0,0 +1,145 @@
+/*
+ * InterleavedHammingCoder.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "InterleavedHammingCoder.h"
+#include "MatrixView.h"
+#include "Status.h"
+
+namespace hamming_code {
+
+int InterleavedHammingCoder::Interleave(const Matrix::Value *words,
+		size_t word_length, size_t depth, size_t number_blocks,
+		Matrix::Value *blocks) {
+	size_t block_length = word_length * depth;
+	for (size_t block_i = 0; block_i < number_blocks; ++block_i) {
+		const Matrix::Value *block_words = words + block_i * block_length;
+		Matrix::Value *block = blocks + block_i * block_length;
+		for (size_t word_i = 0; word_i < depth; ++word_i) {
+			const Matrix::Value *word = block_words + word_i * word_length;
+			for (size_t i = 0; i < word_length; ++i) {
+				block[i * depth + word_i] = word[i];
+			}
+		}
+	}
+	return 0;
+}
+
+int InterleavedHammingCoder::Deinterleave(const Matrix::Value *blocks,
+		size_t word_length, size_t depth, size_t number_blocks,
+		Matrix::Value *words) {
+	size_t block_length = word_length * depth;
+	for (size_t block_i = 0; block_i < number_blocks; ++block_i) {
+		const Matrix::Value *block = blocks + block_i * block_length;
+		Matrix::Value *block_words = words + block_i * block_length;
+		for (size_t word_i = 0; word_i < depth; ++word_i) {
+			Matrix::Value *word = block_words + word_i * word_length;
+			for (size_t i = 0; i < word_length; ++i) {
+				word[i] = block[i * depth + word_i];
+			}
+		}
+	}
+	return 0;
+}
+
+InterleavedHammingCoder::InterleavedHammingCoder(const HammingCoder *coder,
+		size_t depth) :
+		coder_(coder), depth_(depth > 0 ? depth : 1) {
+}
+
+InterleavedHammingCoder::~InterleavedHammingCoder() {
+
+}
+
+int InterleavedHammingCoder::Encode(const Matrix::Value *data_blocks,
+		size_t number_blocks, Matrix::Value *encoded_blocks) const {
+	size_t data_length = coder_->GetDataLength();
+	size_t word_length = coder_->GetWordLength();
+	int ret = kSuccess;
+	for (size_t block_i = 0; block_i < number_blocks; ++block_i) {
+		const MatrixView data(data_length, depth_,
+				const_cast<Matrix::Value *>(data_blocks
+						+ block_i * data_length * depth_));
+		MatrixView encoded(word_length, depth_,
+				encoded_blocks + block_i * word_length * depth_);
+		ret |= coder_->Encode(data, &encoded);
+	}
+	return ret;
+}
+
+int InterleavedHammingCoder::Correct(Matrix::Value *encoded_blocks,
+		size_t number_blocks, MatrixArena *arena) const {
+	size_t word_length = coder_->GetWordLength();
+	int ret = kSuccess;
+	for (size_t block_i = 0; block_i < number_blocks; ++block_i) {
+		MatrixView encoded(word_length, depth_,
+				encoded_blocks + block_i * word_length * depth_);
+		ret |= coder_->Correct(encoded, &encoded, arena);
+	}
+	return ret;
+}
+
+int InterleavedHammingCoder::Decode(const Matrix::Value *encoded_blocks,
+		size_t number_blocks, Matrix::Value *data_blocks) const {
+	size_t data_length = coder_->GetDataLength();
+	size_t word_length = coder_->GetWordLength();
+	int ret = kSuccess;
+	for (size_t block_i = 0; block_i < number_blocks; ++block_i) {
+		const MatrixView encoded(word_length, depth_,
+				const_cast<Matrix::Value *>(encoded_blocks
+						+ block_i * word_length * depth_));
+		MatrixView data(data_length, depth_,
+				data_blocks + block_i * data_length * depth_);
+		ret |= coder_->Decode(encoded, &data);
+	}
+	return ret;
+}
+
+int InterleavedHammingCoder::CorrectAndDecode(
+		const Matrix::Value *encoded_blocks, size_t number_blocks,
+		Matrix::Value *data_blocks) const {
+	size_t data_length = coder_->GetDataLength();
+	size_t word_length = coder_->GetWordLength();
+	int ret = kSuccess;
+	for (size_t block_i = 0; block_i < number_blocks; ++block_i) {
+		const MatrixView encoded(word_length, depth_,
+				const_cast<Matrix::Value *>(encoded_blocks
+						+ block_i * word_length * depth_));
+		MatrixView data(data_length, depth_,
+				data_blocks + block_i * data_length * depth_);
+		ret |= coder_->CorrectAndDecode(encoded, &data);
+	}
+	return ret;
+}
+
+} /* namespace hamming_code */
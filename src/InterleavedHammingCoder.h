@@ -0,0 +1,96 @@
+/*
+ * InterleavedHammingCoder.h
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INTERLEAVEDHAMMINGCODER_H_
+#define INTERLEAVEDHAMMINGCODER_H_
+
+#include <stddef.h>
+#include "HammingCoder.h"
+#include "Matrix.h"
+#include "MatrixArena.h"
+
+namespace hamming_code {
+
+/*
+ * Codes blocks of depth interleaved words, for channels with burst errors.
+ *
+ * Symbol i of word j of a block is stored at i * depth + j, so a block is a
+ * word_length x depth matrix whose columns are the words, and a burst of at
+ * most depth symbols hits every word at most once. Data blocks use the same
+ * layout with data_length rows. Blocks are coded directly through the
+ * MatrixView API of HammingCoder; Interleave and Deinterleave convert from
+ * and to contiguous words at the ends of a pipeline. As with HammingCoder,
+ * the coding functions are const and their scratch memory is an arena passed
+ * by the caller, so one instance can be shared by threads.
+ *
+ * BitSlicedHammingCoder blocks are this layout for binary words with a
+ * depth of BitSlicedHammingCoder::kBlockLength.
+ */
+class InterleavedHammingCoder {
+public:
+	static int Interleave(const Matrix::Value *words, size_t word_length,
+			size_t depth, size_t number_blocks, Matrix::Value *blocks);
+	static int Deinterleave(const Matrix::Value *blocks, size_t word_length,
+			size_t depth, size_t number_blocks, Matrix::Value *words);
+
+	InterleavedHammingCoder(const HammingCoder *coder, size_t depth);
+
+	virtual ~InterleavedHammingCoder();
+
+	int Encode(const Matrix::Value *data_blocks, size_t number_blocks,
+			Matrix::Value *encoded_blocks) const;
+	// Corrects in place. With an arena, the syndromes of each block are
+	// computed by one matrix product into syndrome_length x depth values of
+	// arena memory; the caller resets the arena.
+	int Correct(Matrix::Value *encoded_blocks, size_t number_blocks,
+			MatrixArena *arena = NULL) const;
+	int Decode(const Matrix::Value *encoded_blocks, size_t number_blocks,
+			Matrix::Value *data_blocks) const;
+	int CorrectAndDecode(const Matrix::Value *encoded_blocks,
+			size_t number_blocks, Matrix::Value *data_blocks) const;
+
+	size_t GetDepth() const {
+		return depth_;
+	}
+
+private:
+	InterleavedHammingCoder(const InterleavedHammingCoder &);
+	InterleavedHammingCoder &operator=(const InterleavedHammingCoder &);
+
+	const HammingCoder *coder_;
+	size_t depth_;
+};
+
+} /* namespace hamming_code */
+#endif /* INTERLEAVEDHAMMINGCODER_H_ */
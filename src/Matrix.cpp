@@ -34,6 +34,7 @@
 
 #include <assert.h>
 #include "Matrix.h"
+#include "MatrixView.h"
 
 namespace hamming_code {
 
@@ -52,33 +53,12 @@ int Matrix::Print(std::ostream &ostream, Matrix &matrix) {
 }
 
 int Matrix::Multiply(Matrix &matrix0, Matrix &matrix1, Matrix *ret_matrix) {
-	if (matrix0.GetNumberColums() == matrix1.GetNumberRows()) {
-		size_t number_ret_rows = matrix0.GetNumberRows();
-		size_t number_ret_columns = matrix1.GetNumberColums();
-		size_t number_matrix0_columns = matrix0.GetNumberColums();
-		if (ret_matrix->GetNumberRows() != number_ret_rows
-				|| ret_matrix->GetNumberColums() != number_ret_columns) {
-			*ret_matrix = Matrix(number_ret_rows, number_ret_columns);
-		}
-		Value *matrix0_values = matrix0.GetElements();
-		Value *matrix1_values = matrix1.GetElements();
-		Value *ret_matrix_values = ret_matrix->GetElements();
-		for (size_t row_i = 0; row_i < number_ret_rows; ++row_i) {
-			size_t offset = row_i * number_ret_columns;
-			for (size_t column_i = 0; column_i < number_ret_columns;
-					++column_i) {
-				Value *ret_value = &ret_matrix_values[offset + column_i];
-				*ret_value = 0;
-				for (size_t i = 0; i < number_matrix0_columns; ++i) {
-					*ret_value += matrix0_values[row_i * number_matrix0_columns
-							+ i]
-							* matrix1_values[i * number_ret_columns + column_i];
-				}
-			}
-		}
-		return 0;
+	if (matrix0.GetNumberColums() != matrix1.GetNumberRows()) {
+		return 1;
 	}
-	return 1;
+	ret_matrix->Resize(matrix0.GetNumberRows(), matrix1.GetNumberColums());
+	MatrixView ret_view(*ret_matrix);
+	return MatrixView::Multiply(matrix0, matrix1, &ret_view);
 }
 
 Matrix::Matrix() :
@@ -98,4 +78,10 @@ Matrix::~Matrix() {
 
 }
 
+void Matrix::Resize(size_t number_rows, size_t number_columns) {
+	number_rows_ = number_rows;
+	number_columns_ = number_columns;
+	values_.resize(number_rows * number_columns);
+}
+
 } /* namespace pchindex */
@@ -53,6 +53,9 @@ public:
 	Matrix(size_t number_rows, size_t number_columns, Value *values);
 	virtual ~Matrix();
 
+	// Keeps the allocated storage when it is large enough.
+	void Resize(size_t number_rows, size_t number_columns);
+
 	void SetElement(size_t row, size_t column, Value value) {
 		values_[row*number_columns_ + column] = value;
 	}
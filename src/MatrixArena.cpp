@@ -0,0 +1,86 @@
+/*
+ * MatrixArena.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "MatrixArena.h"
+#include <algorithm>
+
+namespace hamming_code {
+
+MatrixArena::MatrixArena(size_t capacity) :
+		block_i_(0), offset_(0) {
+	if (capacity > 0) {
+		blocks_.push_back(Block(capacity));
+	}
+}
+
+MatrixArena::~MatrixArena() {
+
+}
+
+MatrixView MatrixArena::Allocate(size_t number_rows, size_t number_columns) {
+	size_t length = number_rows * number_columns;
+	while (block_i_ < blocks_.size()
+			&& offset_ + length > blocks_[block_i_].size()) {
+		++block_i_;
+		offset_ = 0;
+	}
+	if (block_i_ == blocks_.size()) {
+		size_t block_length = blocks_.empty() ? 0 : blocks_.back().size() * 2;
+		blocks_.push_back(Block(std::max(std::max(block_length, length), (size_t) 1)));
+		offset_ = 0;
+	}
+	Matrix::Value *values = &blocks_[block_i_][0] + offset_;
+	offset_ += length;
+	return MatrixView(number_rows, number_columns, values);
+}
+
+void MatrixArena::Reset() {
+	if (blocks_.size() > 1) {
+		size_t capacity = GetCapacity();
+		blocks_.clear();
+		blocks_.push_back(Block(capacity));
+	}
+	block_i_ = 0;
+	offset_ = 0;
+}
+
+size_t MatrixArena::GetCapacity() const {
+	size_t capacity = 0;
+	for (size_t i = 0; i < blocks_.size(); ++i) {
+		capacity += blocks_[i].size();
+	}
+	return capacity;
+}
+
+} /* namespace hamming_code */
@@ -0,0 +1,73 @@
+/*
+ * MatrixArena.h
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MATRIXARENA_H_
+#define MATRIXARENA_H_
+
+#include <stddef.h>
+#include <vector>
+#include "Matrix.h"
+#include "MatrixView.h"
+
+namespace hamming_code {
+
+/*
+ * Bump allocator for temporary matrices.
+ *
+ * Allocate hands out views into large blocks and Reset releases all of them
+ * at once. When a cycle between two Resets needed more than one block, Reset
+ * merges them into a single block, so a steady workload stops allocating
+ * after its first cycle.
+ */
+class MatrixArena {
+public:
+	explicit MatrixArena(size_t capacity = 0);
+
+	virtual ~MatrixArena();
+
+	MatrixView Allocate(size_t number_rows, size_t number_columns);
+	void Reset();
+
+	size_t GetCapacity() const;
+
+private:
+	typedef std::vector<Matrix::Value> Block;
+
+	std::vector<Block> blocks_;
+	size_t block_i_;
+	size_t offset_;
+};
+
+} /* namespace hamming_code */
+#endif /* MATRIXARENA_H_ */
@@ -0,0 +1,200 @@
+/*
+ * MatrixView.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "MatrixView.h"
+#include "GaloisField.h"
+#include <algorithm>
+
+namespace hamming_code {
+
+const size_t MatrixView::kBlockedMultiplyThreshold;
+const size_t MatrixView::kMicroRows;
+const size_t MatrixView::kMicroColumns;
+const size_t MatrixView::kPanelLength;
+const size_t MatrixView::kPanelColumns;
+
+int MatrixView::Multiply(const MatrixView &view0, const MatrixView &view1,
+		MatrixView *ret_view, const GaloisField *field) {
+	if (view0.GetNumberColums() != view1.GetNumberRows()
+			|| ret_view->GetNumberRows() != view0.GetNumberRows()
+			|| ret_view->GetNumberColums() != view1.GetNumberColums()) {
+		return 1;
+	}
+	if (view0.GetNumberColums() * view1.GetNumberColums()
+			>= kBlockedMultiplyThreshold) {
+		MultiplyBlocked(view0, view1, field, ret_view);
+	} else {
+		MultiplyNaive(view0, view1, field, ret_view);
+	}
+	return 0;
+}
+
+int MatrixView::Copy(const MatrixView &view, MatrixView *ret_view) {
+	if (view.GetNumberRows() != ret_view->GetNumberRows()
+			|| view.GetNumberColums() != ret_view->GetNumberColums()) {
+		return 1;
+	}
+	const Value *values = view.GetElements();
+	if (values != ret_view->GetElements()) {
+		std::copy(values, values + view.GetNumberRows() * view.GetNumberColums(),
+				ret_view->GetElements());
+	}
+	return 0;
+}
+
+void MatrixView::MultiplyNaive(const MatrixView &view0,
+		const MatrixView &view1, const GaloisField *field,
+		MatrixView *ret_view) {
+	size_t number_ret_rows = view0.GetNumberRows();
+	size_t number_ret_columns = view1.GetNumberColums();
+	size_t number_view0_columns = view0.GetNumberColums();
+	const Value *view0_values = view0.GetElements();
+	const Value *view1_values = view1.GetElements();
+	Value *ret_view_values = ret_view->GetElements();
+	for (size_t row_i = 0; row_i < number_ret_rows; ++row_i) {
+		size_t offset = row_i * number_ret_columns;
+		for (size_t column_i = 0; column_i < number_ret_columns; ++column_i) {
+			int sum = 0;
+			for (size_t i = 0; i < number_view0_columns; ++i) {
+				sum += view0_values[row_i * number_view0_columns + i]
+						* view1_values[i * number_ret_columns + column_i];
+			}
+			ret_view_values[offset + column_i] =
+					field == NULL ? sum : field->Reduce(sum);
+		}
+	}
+}
+
+// The right operand is copied panel by panel into kMicroColumns wide
+// slivers, so the micro-kernel reads both operands sequentially. Sums are
+// exact in int; they wrap into Value like the naive loop does or are reduced
+// once per panel.
+void MatrixView::MultiplyBlocked(const MatrixView &view0,
+		const MatrixView &view1, const GaloisField *field,
+		MatrixView *ret_view) {
+	size_t number_ret_rows = view0.GetNumberRows();
+	size_t number_ret_columns = view1.GetNumberColums();
+	size_t number_view0_columns = view0.GetNumberColums();
+	const Value *view0_values = view0.GetElements();
+	Value *ret_view_values = ret_view->GetElements();
+	std::fill(ret_view_values,
+			ret_view_values + number_ret_rows * number_ret_columns, 0);
+	Value panel[kPanelLength * kPanelColumns];
+	int sums[kMicroRows * kMicroColumns];
+	const Value *rows[kMicroRows];
+	for (size_t k_begin = 0; k_begin < number_view0_columns; k_begin +=
+			kPanelLength) {
+		size_t length = std::min(kPanelLength, number_view0_columns - k_begin);
+		for (size_t column_begin = 0; column_begin < number_ret_columns;
+				column_begin += kPanelColumns) {
+			size_t number_panel_columns = std::min(kPanelColumns,
+					number_ret_columns - column_begin);
+			PackPanel(view1, k_begin, length, column_begin,
+					number_panel_columns, panel);
+			for (size_t row_begin = 0; row_begin < number_ret_rows; row_begin +=
+					kMicroRows) {
+				size_t number_rows = std::min(kMicroRows,
+						number_ret_rows - row_begin);
+				for (size_t i = 0; i < kMicroRows; ++i) {
+					// Missing rows repeat the first one; their sums are dropped.
+					size_t row_i = row_begin + (i < number_rows ? i : 0);
+					rows[i] = view0_values + row_i * number_view0_columns
+							+ k_begin;
+				}
+				for (size_t sliver_begin = 0;
+						sliver_begin < number_panel_columns; sliver_begin +=
+								kMicroColumns) {
+					MultiplyMicroKernel(rows, panel + sliver_begin * length,
+							length, sums);
+					size_t number_columns = std::min(kMicroColumns,
+							number_panel_columns - sliver_begin);
+					for (size_t i = 0; i < number_rows; ++i) {
+						Value *ret_row = ret_view_values
+								+ (row_begin + i) * number_ret_columns
+								+ column_begin + sliver_begin;
+						const int *row_sums = sums + i * kMicroColumns;
+						if (field == NULL) {
+							for (size_t j = 0; j < number_columns; ++j) {
+								ret_row[j] += row_sums[j];
+							}
+						} else {
+							for (size_t j = 0; j < number_columns; ++j) {
+								ret_row[j] = field->Reduce(
+										ret_row[j] + row_sums[j]);
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+void MatrixView::PackPanel(const MatrixView &view, size_t row_begin,
+		size_t length, size_t column_begin, size_t number_columns,
+		Value *panel) {
+	size_t number_view_columns = view.GetNumberColums();
+	const Value *values = view.GetElements();
+	for (size_t sliver_begin = 0; sliver_begin < number_columns;
+			sliver_begin += kMicroColumns) {
+		size_t sliver_columns = std::min(kMicroColumns,
+				number_columns - sliver_begin);
+		Value *sliver = panel + sliver_begin * length;
+		for (size_t k = 0; k < length; ++k) {
+			const Value *row = values + (row_begin + k) * number_view_columns
+					+ column_begin + sliver_begin;
+			Value *packed = sliver + k * kMicroColumns;
+			for (size_t j = 0; j < kMicroColumns; ++j) {
+				packed[j] = j < sliver_columns ? row[j] : 0;
+			}
+		}
+	}
+}
+
+void MatrixView::MultiplyMicroKernel(const Value * const *rows,
+		const Value *panel, size_t length, int *sums) {
+	std::fill(sums, sums + kMicroRows * kMicroColumns, 0);
+	for (size_t k = 0; k < length; ++k) {
+		const Value *packed = panel + k * kMicroColumns;
+		for (size_t i = 0; i < kMicroRows; ++i) {
+			int a = rows[i][k];
+			int *row_sums = sums + i * kMicroColumns;
+			for (size_t j = 0; j < kMicroColumns; ++j) {
+				row_sums[j] += a * packed[j];
+			}
+		}
+	}
+}
+
+} /* namespace hamming_code */
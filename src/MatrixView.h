@@ -0,0 +1,128 @@
+/*
+ * MatrixView.h
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MATRIXVIEW_H_
+#define MATRIXVIEW_H_
+
+#include <stddef.h>
+#include "Matrix.h"
+
+namespace hamming_code {
+
+class GaloisField;
+
+/*
+ * Matrix over memory owned by someone else, e.g. a Matrix, a MatrixArena or
+ * a caller buffer. Functions taking views never allocate: the shape of an
+ * output view has to match already.
+ */
+class MatrixView {
+public:
+	typedef Matrix::Value Value;
+
+	// Returns 1 if the shapes do not match. Products with at least
+	// kBlockedMultiplyThreshold inner-length x result-column pairs use the
+	// cache-blocked kernel; both kernels give the same result. Without a
+	// field the sums wrap in Value; with one, the elements have to be in the
+	// field and the result is reduced into it.
+	static const size_t kBlockedMultiplyThreshold = 32768;
+
+	static int Multiply(const MatrixView &view0, const MatrixView &view1,
+			MatrixView *ret_view, const GaloisField *field = NULL);
+	static int Copy(const MatrixView &view, MatrixView *ret_view);
+
+	MatrixView() :
+			number_rows_(0), number_columns_(0), values_(NULL) {
+	}
+
+	MatrixView(size_t number_rows, size_t number_columns, Value *values) :
+			number_rows_(number_rows), number_columns_(number_columns), values_(
+					values) {
+	}
+
+	MatrixView(Matrix &matrix) :
+			number_rows_(matrix.GetNumberRows()), number_columns_(
+					matrix.GetNumberColums()), values_(matrix.GetElements()) {
+	}
+
+	void SetElement(size_t row, size_t column, Value value) {
+		values_[row * number_columns_ + column] = value;
+	}
+
+	Value GetElement(size_t row, size_t column) const {
+		return values_[row * number_columns_ + column];
+	}
+
+	const Value* GetElements() const {
+		return values_;
+	}
+
+	Value* GetElements() {
+		return values_;
+	}
+
+	size_t GetNumberRows() const {
+		return number_rows_;
+	}
+
+	size_t GetNumberColums() const {
+		return number_columns_;
+	}
+
+private:
+	// Register block of the micro-kernel and cache block of the packed
+	// right operand, which lives on the stack (16 KiB).
+	static const size_t kMicroRows = 4;
+	static const size_t kMicroColumns = 8;
+	static const size_t kPanelLength = 256;
+	static const size_t kPanelColumns = 64;
+
+	static void MultiplyNaive(const MatrixView &view0, const MatrixView &view1,
+			const GaloisField *field, MatrixView *ret_view);
+	static void MultiplyBlocked(const MatrixView &view0,
+			const MatrixView &view1, const GaloisField *field,
+			MatrixView *ret_view);
+	static void PackPanel(const MatrixView &view, size_t row_begin,
+			size_t length, size_t column_begin, size_t number_columns,
+			Value *panel);
+	static void MultiplyMicroKernel(const Value * const *rows,
+			const Value *panel, size_t length, int *sums);
+
+	size_t number_rows_;
+	size_t number_columns_;
+	Value *values_;
+};
+
+} /* namespace hamming_code */
+#endif /* MATRIXVIEW_H_ */
@@ -0,0 +1,111 @@
+/*
+ * ParallelHammingCoder.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ParallelHammingCoder.h"
+#include "Status.h"
+#include <algorithm>
+#include <vector>
+
+namespace hamming_code {
+
+ParallelHammingCoder::ParallelHammingCoder(const HammingCoder *coder,
+		size_t number_threads, size_t chunk_length) :
+		coder_(coder), chunk_length_(chunk_length > 0 ? chunk_length : 1), thread_pool_(
+				number_threads) {
+}
+
+ParallelHammingCoder::~ParallelHammingCoder() {
+
+}
+
+int ParallelHammingCoder::Encode(const Matrix::Value *data,
+		size_t number_words, Matrix::Value *encoded_data) {
+	return Run(kEncode, data, coder_->GetDataLength(), number_words,
+			encoded_data, coder_->GetWordLength());
+}
+
+int ParallelHammingCoder::Correct(const Matrix::Value *data,
+		size_t number_words, Matrix::Value *corrected_data) {
+	return Run(kCorrect, data, coder_->GetWordLength(), number_words,
+			corrected_data, coder_->GetWordLength());
+}
+
+int ParallelHammingCoder::Decode(const Matrix::Value *encoded_data,
+		size_t number_words, Matrix::Value *data) {
+	return Run(kDecode, encoded_data, coder_->GetWordLength(), number_words,
+			data, coder_->GetDataLength());
+}
+
+void ParallelHammingCoder::CodingTask::Run() {
+	switch (operation_) {
+	case kEncode:
+		status_ = coder_->Encode(input_, number_words_, output_);
+		break;
+	case kCorrect:
+		status_ = coder_->Correct(input_, number_words_, output_);
+		break;
+	case kDecode:
+		status_ = coder_->Decode(input_, number_words_, output_);
+		break;
+	}
+}
+
+int ParallelHammingCoder::Run(Operation operation,
+		const Matrix::Value *input, size_t input_word_length,
+		size_t number_words, Matrix::Value *output,
+		size_t output_word_length) {
+	size_t number_chunks = (number_words + chunk_length_ - 1) / chunk_length_;
+	if (tasks_.size() < number_chunks) {
+		tasks_.resize(number_chunks);
+	}
+	int ret = kSuccess;
+	for (size_t chunk_i = 0; chunk_i < number_chunks; ++chunk_i) {
+		size_t word_offset = chunk_i * chunk_length_;
+		size_t chunk_words = std::min(chunk_length_, number_words - word_offset);
+		tasks_[chunk_i] = CodingTask(coder_, operation,
+				input + word_offset * input_word_length, chunk_words,
+				output + word_offset * output_word_length);
+		ret |= thread_pool_.Submit(&tasks_[chunk_i]);
+	}
+	thread_pool_.Wait();
+	if (ret != kSuccess) {
+		return ret;
+	}
+	for (size_t chunk_i = 0; chunk_i < number_chunks; ++chunk_i) {
+		ret |= tasks_[chunk_i].GetStatus();
+	}
+	return ret;
+}
+
+} /* namespace hamming_code */
@@ -0,0 +1,126 @@
+/*
+ * ParallelHammingCoder.h
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PARALLELHAMMINGCODER_H_
+#define PARALLELHAMMINGCODER_H_
+
+#include <stddef.h>
+#include <vector>
+#include "HammingCoder.h"
+#include "Matrix.h"
+#include "ThreadPool.h"
+
+namespace hamming_code {
+
+/*
+ * Codes large buffers of contiguous words on a thread pool.
+ *
+ * The buffer is split into chunks of whole words and every chunk is coded by
+ * the shared HammingCoder, whose const functions need no locking. A call
+ * returns after all of its chunks are done, so calls must not overlap.
+ */
+class ParallelHammingCoder {
+public:
+	static const size_t kDefaultChunkLength = 4096;
+
+	// Uses one thread per online processor when number_threads is 0.
+	ParallelHammingCoder(const HammingCoder *coder, size_t number_threads,
+			size_t chunk_length = kDefaultChunkLength);
+
+	virtual ~ParallelHammingCoder();
+
+	// Return kThreadError if no worker thread could be started.
+	int Encode(const Matrix::Value *data, size_t number_words,
+			Matrix::Value *encoded_data);
+	int Correct(const Matrix::Value *data, size_t number_words,
+			Matrix::Value *corrected_data);
+	int Decode(const Matrix::Value *encoded_data, size_t number_words,
+			Matrix::Value *data);
+
+	size_t GetNumberThreads() const {
+		return thread_pool_.GetNumberThreads();
+	}
+
+private:
+	static const size_t kCacheLineLength = 64;
+
+	enum Operation {
+		kEncode, kCorrect, kDecode
+	};
+
+	class CodingTask: public ThreadPool::Task {
+	public:
+		CodingTask() :
+				coder_(NULL), operation_(kEncode), input_(NULL), number_words_(
+						0), output_(NULL), status_(0) {
+		}
+		CodingTask(const HammingCoder *coder, Operation operation,
+				const Matrix::Value *input, size_t number_words,
+				Matrix::Value *output) :
+				coder_(coder), operation_(operation), input_(input), number_words_(
+						number_words), output_(output), status_(0) {
+		}
+		virtual void Run();
+
+		int GetStatus() const {
+			return status_;
+		}
+
+	private:
+		const HammingCoder *coder_;
+		Operation operation_;
+		const Matrix::Value *input_;
+		size_t number_words_;
+		Matrix::Value *output_;
+		// On its own cache line, so workers finishing neighbouring tasks do
+		// not share one.
+		int status_ __attribute__((aligned(kCacheLineLength)));
+	};
+
+	ParallelHammingCoder(const ParallelHammingCoder &);
+	ParallelHammingCoder &operator=(const ParallelHammingCoder &);
+
+	int Run(Operation operation, const Matrix::Value *input,
+			size_t input_word_length, size_t number_words,
+			Matrix::Value *output, size_t output_word_length);
+
+	const HammingCoder *coder_;
+	size_t chunk_length_;
+	// Reused by every call, so a steady workload does not allocate tasks.
+	std::vector<CodingTask> tasks_;
+	ThreadPool thread_pool_;
+};
+
+} /* namespace hamming_code */
+#endif /* PARALLELHAMMINGCODER_H_ */
@@ -0,0 +1,156 @@
+/*
+ * SparseMatrix.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "SparseMatrix.h"
+#include "GaloisField.h"
+#include <string.h>
+#include <algorithm>
+
+namespace hamming_code {
+
+const size_t SparseMatrix::kChunkColumns;
+
+// Each row of the result is a sum of the rows of view selected by the
+// nonzeros of the matching row of matrix, accumulated kChunkColumns
+// columns at a time.
+int SparseMatrix::Multiply(const SparseMatrix &matrix, const MatrixView &view,
+		MatrixView *ret_view, const GaloisField *field) {
+	if (matrix.number_columns_ != view.GetNumberRows()
+			|| ret_view->GetNumberRows() != matrix.number_rows_
+			|| ret_view->GetNumberColums() != view.GetNumberColums()) {
+		return 1;
+	}
+	size_t number_columns = view.GetNumberColums();
+	Value *ret_view_values = ret_view->GetElements();
+	int sums[kChunkColumns];
+	for (size_t column_begin = 0; column_begin < number_columns;
+			column_begin += kChunkColumns) {
+		size_t length = std::min(kChunkColumns, number_columns - column_begin);
+		for (size_t row_i = 0; row_i < matrix.number_rows_; ++row_i) {
+			matrix.MultiplyRow(row_i, view, column_begin, length, sums);
+			Value *ret_row = ret_view_values + row_i * number_columns
+					+ column_begin;
+			if (field == NULL) {
+				for (size_t j = 0; j < length; ++j) {
+					ret_row[j] = sums[j];
+				}
+			} else {
+				for (size_t j = 0; j < length; ++j) {
+					ret_row[j] = field->Reduce(sums[j]);
+				}
+			}
+		}
+	}
+	return 0;
+}
+
+SparseMatrix::SparseMatrix() :
+		number_rows_(0), number_columns_(0), unit_values_(true), row_offsets_(1,
+				0) {
+
+}
+
+SparseMatrix::SparseMatrix(const MatrixView &view) :
+		number_rows_(0), number_columns_(0), unit_values_(true) {
+	Assign(view);
+}
+
+SparseMatrix::~SparseMatrix() {
+
+}
+
+int SparseMatrix::Assign(const MatrixView &view) {
+	number_rows_ = view.GetNumberRows();
+	number_columns_ = view.GetNumberColums();
+	unit_values_ = true;
+	row_offsets_.assign(1, 0);
+	column_indices_.clear();
+	values_.clear();
+	for (size_t row_i = 0; row_i < number_rows_; ++row_i) {
+		for (size_t column_i = 0; column_i < number_columns_; ++column_i) {
+			Value value = view.GetElement(row_i, column_i);
+			if (value != 0) {
+				column_indices_.push_back(column_i);
+				values_.push_back(value);
+				unit_values_ = unit_values_ && value == 1;
+			}
+		}
+		row_offsets_.push_back(column_indices_.size());
+	}
+	return 0;
+}
+
+void SparseMatrix::MultiplyRow(size_t row_i, const MatrixView &view,
+		size_t column_begin, size_t length, int *sums) const {
+	size_t number_columns = view.GetNumberColums();
+	const Value *view_values = view.GetElements() + column_begin;
+	std::fill(sums, sums + length, 0);
+	for (uint32_t i = row_offsets_[row_i]; i < row_offsets_[row_i + 1]; ++i) {
+		const Value *row = view_values + column_indices_[i] * number_columns;
+		int value = values_[i];
+		if (value == 1) {
+			for (size_t j = 0; j < length; ++j) {
+				sums[j] += row[j];
+			}
+		} else {
+			for (size_t j = 0; j < length; ++j) {
+				sums[j] += value * row[j];
+			}
+		}
+	}
+}
+
+void SparseMatrix::MultiplyBinaryRow(size_t row_i, const MatrixView &view,
+		size_t column_begin, size_t length, Value *parities) const {
+	size_t number_columns = view.GetNumberColums();
+	const Value *view_values = view.GetElements() + column_begin;
+	std::fill(parities, parities + length, 0);
+	for (uint32_t i = row_offsets_[row_i]; i < row_offsets_[row_i + 1]; ++i) {
+		const Value *row = view_values + column_indices_[i] * number_columns;
+		size_t j = 0;
+		for (; j + sizeof(uint64_t) <= length; j += sizeof(uint64_t)) {
+			uint64_t parity;
+			uint64_t value;
+			memcpy(&parity, parities + j, sizeof(uint64_t));
+			memcpy(&value, row + j, sizeof(uint64_t));
+			parity ^= value;
+			memcpy(parities + j, &parity, sizeof(uint64_t));
+		}
+		for (; j < length; ++j) {
+			parities[j] ^= row[j];
+		}
+	}
+}
+
+} /* namespace hamming_code */
@@ -0,0 +1,122 @@
+/*
+ * SparseMatrix.h
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SPARSEMATRIX_H_
+#define SPARSEMATRIX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "Matrix.h"
+#include "MatrixView.h"
+
+namespace hamming_code {
+
+class GaloisField;
+
+/*
+ * Compressed sparse row copy of a dense matrix. Products only visit the
+ * nonzero elements, which pays off for Hamming generator, checker and
+ * receiver matrices, most of whose elements are 0.
+ */
+class SparseMatrix {
+public:
+	typedef Matrix::Value Value;
+
+	// Same contract as MatrixView::Multiply: returns 1 if the shapes do not
+	// match and reduces the result into field if one is given.
+	static int Multiply(const SparseMatrix &matrix, const MatrixView &view,
+			MatrixView *ret_view, const GaloisField *field = NULL);
+
+	SparseMatrix();
+	explicit SparseMatrix(const MatrixView &view);
+	virtual ~SparseMatrix();
+
+	int Assign(const MatrixView &view);
+
+	// Unreduced dot product of row row_i with vector, whose elements are
+	// stride values apart.
+	int MultiplyRow(size_t row_i, const Value *vector, size_t stride) const {
+		int sum = 0;
+		uint32_t end = row_offsets_[row_i + 1];
+		if (unit_values_) {
+			for (uint32_t i = row_offsets_[row_i]; i < end; ++i) {
+				sum += vector[column_indices_[i] * stride];
+			}
+		} else {
+			for (uint32_t i = row_offsets_[row_i]; i < end; ++i) {
+				sum += values_[i] * vector[column_indices_[i] * stride];
+			}
+		}
+		return sum;
+	}
+
+	// Unreduced products of row row_i with the length columns of view from
+	// column_begin on, one per sum.
+	void MultiplyRow(size_t row_i, const MatrixView &view, size_t column_begin,
+			size_t length, int *sums) const;
+	// Same for binary matrices and views: the products mod 2, computed by
+	// XORing 8 columns at a time.
+	void MultiplyBinaryRow(size_t row_i, const MatrixView &view,
+			size_t column_begin, size_t length, Value *parities) const;
+
+	size_t GetNumberRows() const {
+		return number_rows_;
+	}
+
+	size_t GetNumberColums() const {
+		return number_columns_;
+	}
+
+	size_t GetNumberNonzeros() const {
+		return column_indices_.size();
+	}
+
+private:
+	// Result columns computed at a time; their sums live on the stack.
+	static const size_t kChunkColumns = 256;
+
+	size_t number_rows_;
+	size_t number_columns_;
+	// Set when every nonzero element is 1, as in binary codes, so products
+	// need no multiplications.
+	bool unit_values_;
+	// Row row_i has the nonzeros [row_offsets_[row_i], row_offsets_[row_i + 1]).
+	std::vector<uint32_t> row_offsets_;
+	std::vector<uint32_t> column_indices_;
+	std::vector<Value> values_;
+};
+
+} /* namespace hamming_code */
+#endif /* SPARSEMATRIX_H_ */
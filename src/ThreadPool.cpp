@@ -0,0 +1,174 @@
+/*
+ * ThreadPool.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ThreadPool.h"
+#include "Status.h"
+#include <unistd.h>
+#include <assert.h>
+
+namespace hamming_code {
+
+ThreadPool::ThreadPool(size_t number_threads) :
+		number_queued_tasks_(0), number_pending_tasks_(0), next_worker_id_(0), stop_(
+				false) {
+	if (number_threads == 0) {
+		long number_processors = sysconf(_SC_NPROCESSORS_ONLN);
+		number_threads = number_processors > 0 ? number_processors : 1;
+	}
+	pthread_mutex_init(&mutex_, NULL);
+	pthread_cond_init(&task_cond_, NULL);
+	pthread_cond_init(&done_cond_, NULL);
+	for (size_t i = 0; i < number_threads; ++i) {
+		Worker *worker = new Worker;
+		worker->pool = this;
+		worker->id = i;
+		pthread_mutex_init(&worker->mutex, NULL);
+		workers_.push_back(worker);
+	}
+	// Workers wait for mutex_ before reading workers_, which shrinks if a
+	// thread cannot be created.
+	pthread_mutex_lock(&mutex_);
+	for (size_t i = 0; i < number_threads; ++i) {
+		if (pthread_create(&workers_[i]->thread, NULL, RunWorker, workers_[i])
+				!= 0) {
+			for (size_t j = i; j < number_threads; ++j) {
+				pthread_mutex_destroy(&workers_[j]->mutex);
+				delete workers_[j];
+			}
+			workers_.resize(i);
+			break;
+		}
+	}
+	pthread_mutex_unlock(&mutex_);
+}
+
+ThreadPool::~ThreadPool() {
+	pthread_mutex_lock(&mutex_);
+	stop_ = true;
+	pthread_cond_broadcast(&task_cond_);
+	pthread_mutex_unlock(&mutex_);
+	for (size_t i = 0; i < workers_.size(); ++i) {
+		pthread_join(workers_[i]->thread, NULL);
+	}
+	for (size_t i = 0; i < workers_.size(); ++i) {
+		pthread_mutex_destroy(&workers_[i]->mutex);
+		delete workers_[i];
+	}
+	pthread_cond_destroy(&done_cond_);
+	pthread_cond_destroy(&task_cond_);
+	pthread_mutex_destroy(&mutex_);
+}
+
+int ThreadPool::Submit(Task *task) {
+	if (workers_.empty()) {
+		return kThreadError;
+	}
+	pthread_mutex_lock(&mutex_);
+	Worker *worker = workers_[next_worker_id_];
+	next_worker_id_ = (next_worker_id_ + 1) % workers_.size();
+	pthread_mutex_lock(&worker->mutex);
+	worker->tasks.push_back(task);
+	pthread_mutex_unlock(&worker->mutex);
+	++number_queued_tasks_;
+	++number_pending_tasks_;
+	pthread_cond_signal(&task_cond_);
+	pthread_mutex_unlock(&mutex_);
+	return 0;
+}
+
+int ThreadPool::Wait() {
+	pthread_mutex_lock(&mutex_);
+	while (number_pending_tasks_ > 0) {
+		pthread_cond_wait(&done_cond_, &mutex_);
+	}
+	pthread_mutex_unlock(&mutex_);
+	return 0;
+}
+
+void *ThreadPool::RunWorker(void *arg) {
+	Worker *worker = static_cast<Worker *>(arg);
+	ThreadPool *pool = worker->pool;
+	pthread_mutex_lock(&pool->mutex_);
+	pthread_mutex_unlock(&pool->mutex_);
+	while (true) {
+		Task *task = NULL;
+		if (pool->PopTask(worker->id, &task)) {
+			task->Run();
+			pthread_mutex_lock(&pool->mutex_);
+			assert(pool->number_pending_tasks_ > 0);
+			--pool->number_pending_tasks_;
+			if (pool->number_pending_tasks_ == 0) {
+				pthread_cond_broadcast(&pool->done_cond_);
+			}
+			pthread_mutex_unlock(&pool->mutex_);
+			continue;
+		}
+		pthread_mutex_lock(&pool->mutex_);
+		while (pool->number_queued_tasks_ == 0 && !pool->stop_) {
+			pthread_cond_wait(&pool->task_cond_, &pool->mutex_);
+		}
+		bool stop = pool->stop_ && pool->number_queued_tasks_ == 0;
+		pthread_mutex_unlock(&pool->mutex_);
+		if (stop) {
+			break;
+		}
+	}
+	return NULL;
+}
+
+bool ThreadPool::PopTask(size_t worker_id, Task **task) {
+	size_t number_workers = workers_.size();
+	for (size_t i = 0; i < number_workers; ++i) {
+		Worker *worker = workers_[(worker_id + i) % number_workers];
+		pthread_mutex_lock(&worker->mutex);
+		if (!worker->tasks.empty()) {
+			if (i == 0) {
+				*task = worker->tasks.back();
+				worker->tasks.pop_back();
+			} else {
+				*task = worker->tasks.front();
+				worker->tasks.pop_front();
+			}
+			pthread_mutex_unlock(&worker->mutex);
+			pthread_mutex_lock(&mutex_);
+			--number_queued_tasks_;
+			pthread_mutex_unlock(&mutex_);
+			return true;
+		}
+		pthread_mutex_unlock(&worker->mutex);
+	}
+	return false;
+}
+
+} /* namespace hamming_code */
@@ -0,0 +1,104 @@
+/*
+ * ThreadPool.h
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <stddef.h>
+#include <pthread.h>
+#include <deque>
+#include <vector>
+
+namespace hamming_code {
+
+/*
+ * Fixed size pool of pthreads with one task deque per worker.
+ *
+ * Submitted tasks are distributed round-robin over the workers. A worker
+ * takes tasks from the back of its own deque and, when that is empty, steals
+ * from the front of the other workers' deques.
+ */
+class ThreadPool {
+public:
+	class Task {
+	public:
+		virtual ~Task() {
+		}
+		virtual void Run() = 0;
+	};
+
+	// Uses one thread per online processor when number_threads is 0. Keeps
+	// the threads started before pthread_create fails, if any.
+	explicit ThreadPool(size_t number_threads);
+
+	virtual ~ThreadPool();
+
+	// The task is not owned by the pool and must live until Wait returns.
+	// Returns kThreadError without queueing it if the pool has no thread.
+	int Submit(Task *task);
+	// Blocks until every submitted task has finished.
+	int Wait();
+
+	size_t GetNumberThreads() const {
+		return workers_.size();
+	}
+
+private:
+	struct Worker {
+		ThreadPool *pool;
+		size_t id;
+		pthread_t thread;
+		pthread_mutex_t mutex;
+		std::deque<Task *> tasks;
+	};
+
+	static void *RunWorker(void *arg);
+
+	ThreadPool(const ThreadPool &);
+	ThreadPool &operator=(const ThreadPool &);
+
+	bool PopTask(size_t worker_id, Task **task);
+
+	pthread_mutex_t mutex_;
+	pthread_cond_t task_cond_;
+	pthread_cond_t done_cond_;
+	size_t number_queued_tasks_;
+	size_t number_pending_tasks_;
+	size_t next_worker_id_;
+	bool stop_;
+	std::vector<Worker *> workers_;
+};
+
+} /* namespace hamming_code */
+#endif /* THREADPOOL_H_ */
@@ -0,0 +1,305 @@
+/*
+ * AsyncHammingCoderTest.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+#include "../src/AsyncHammingCoder.h"
+#include "../src/CodingStatistics.h"
+#include "../src/HammingCodeFactory.h"
+#include "../src/HammingCoder.h"
+#include "../src/Matrix.h"
+#include "../src/Status.h"
+
+using namespace std;
+
+namespace {
+
+class CountingJob: public hamming_code::AsyncHammingCoder::Job {
+public:
+	CountingJob(hamming_code::AsyncHammingCoder::Operation operation,
+			const hamming_code::Matrix::Value *data, size_t number_words,
+			hamming_code::Matrix::Value *ret_data, size_t *number_completed) :
+			Job(operation, data, number_words, ret_data), number_completed_(
+					number_completed) {
+	}
+
+	virtual void Complete(int) {
+		__atomic_fetch_add(number_completed_, 1, __ATOMIC_RELAXED);
+	}
+
+private:
+	size_t *number_completed_;
+};
+
+// Holds its worker in Complete until Release, so the jobs submitted
+// meanwhile stay queued.
+class BlockingJob: public hamming_code::AsyncHammingCoder::Job {
+public:
+	BlockingJob(const hamming_code::Matrix::Value *data,
+			hamming_code::Matrix::Value *ret_data) :
+			Job(hamming_code::AsyncHammingCoder::kEncode, data, 1, ret_data), entered_(
+					false), released_(false) {
+		pthread_mutex_init(&mutex_, NULL);
+		pthread_cond_init(&cond_, NULL);
+	}
+
+	virtual ~BlockingJob() {
+		pthread_cond_destroy(&cond_);
+		pthread_mutex_destroy(&mutex_);
+	}
+
+	virtual void Complete(int) {
+		pthread_mutex_lock(&mutex_);
+		entered_ = true;
+		pthread_cond_broadcast(&cond_);
+		while (!released_) {
+			pthread_cond_wait(&cond_, &mutex_);
+		}
+		pthread_mutex_unlock(&mutex_);
+	}
+
+	void WaitEntered() {
+		pthread_mutex_lock(&mutex_);
+		while (!entered_) {
+			pthread_cond_wait(&cond_, &mutex_);
+		}
+		pthread_mutex_unlock(&mutex_);
+	}
+
+	void Release() {
+		pthread_mutex_lock(&mutex_);
+		released_ = true;
+		pthread_cond_broadcast(&cond_);
+		pthread_mutex_unlock(&mutex_);
+	}
+
+private:
+	pthread_mutex_t mutex_;
+	pthread_cond_t cond_;
+	bool entered_;
+	bool released_;
+};
+
+}
+
+class AsyncHammingCoderTest: public ::testing::Test {
+protected:
+	virtual void SetUp() {
+		hamming_code::HammingCodeFactory::CreateCoder(2, 4, &hamming_coder_);
+	}
+
+	virtual void TearDown() {
+	}
+	hamming_code::HammingCoder hamming_coder_;
+};
+
+TEST_F(AsyncHammingCoderTest, EncodeAndCorrect) {
+	size_t number_jobs = 64;
+	size_t job_length = 5;
+	size_t number_words = number_jobs * job_length;
+	vector<hamming_code::Matrix::Value> data(number_words * 11);
+	for (size_t i = 0; i < data.size(); ++i) {
+		data[i] = (i * 5 + i / 7) % 2;
+	}
+	vector<hamming_code::Matrix::Value> expected_data(number_words * 15);
+	EXPECT_EQ(0, hamming_coder_.Encode(&data[0], number_words,
+			&expected_data[0]));
+
+	size_t number_completed = 0;
+	vector<hamming_code::Matrix::Value> encoded_data(expected_data.size());
+	{
+		// A short queue makes Submit wait for the workers.
+		hamming_code::AsyncHammingCoder coder(&hamming_coder_, 2, 4);
+		EXPECT_EQ(2u, coder.GetNumberThreads());
+		vector<CountingJob *> jobs;
+		for (size_t i = 0; i < number_jobs; ++i) {
+			jobs.push_back(new CountingJob(
+					hamming_code::AsyncHammingCoder::kEncode,
+					&data[i * job_length * 11], job_length,
+					&encoded_data[i * job_length * 15], &number_completed));
+			EXPECT_EQ(hamming_code::kSuccess, coder.Submit(jobs.back()));
+		}
+		for (size_t i = 0; i < number_jobs; ++i) {
+			EXPECT_EQ(hamming_code::kSuccess, coder.Wait(jobs[i]));
+			delete jobs[i];
+		}
+		EXPECT_EQ(number_jobs, number_completed);
+		EXPECT_TRUE(expected_data == encoded_data);
+
+		// Scrub in place, one error in every other word.
+		for (size_t i = 0; i < number_words; i += 2) {
+			encoded_data[i * 15 + i % 15] ^= 1;
+		}
+		for (size_t i = 0; i < number_jobs; ++i) {
+			hamming_code::Matrix::Value *words = &encoded_data[i * job_length
+					* 15];
+			jobs[i] = new CountingJob(hamming_code::AsyncHammingCoder::kCorrect,
+					words, job_length, words, &number_completed);
+			EXPECT_EQ(hamming_code::kSuccess, coder.Submit(jobs[i]));
+		}
+		for (size_t i = 0; i < number_jobs; ++i) {
+			EXPECT_EQ(hamming_code::kSuccess, coder.Wait(jobs[i]));
+			delete jobs[i];
+		}
+	}
+	EXPECT_EQ(2 * number_jobs, number_completed);
+	EXPECT_TRUE(expected_data == encoded_data);
+}
+
+TEST_F(AsyncHammingCoderTest, TrySubmitToFullQueue) {
+	vector<hamming_code::Matrix::Value> data(4 * 11, 1);
+	vector<hamming_code::Matrix::Value> encoded_data(4 * 15);
+	hamming_code::AsyncHammingCoder coder(&hamming_coder_, 1, 1);
+	BlockingJob blocking_job(&data[0], &encoded_data[0]);
+	EXPECT_EQ(hamming_code::kSuccess, coder.Submit(&blocking_job));
+	blocking_job.WaitEntered();
+
+	hamming_code::AsyncHammingCoder::Job queued_job(
+			hamming_code::AsyncHammingCoder::kEncode, &data[11], 1,
+			&encoded_data[15]);
+	hamming_code::AsyncHammingCoder::Job rejected_job(
+			hamming_code::AsyncHammingCoder::kEncode, &data[22], 2,
+			&encoded_data[30]);
+	EXPECT_EQ(hamming_code::kSuccess, coder.TrySubmit(&queued_job));
+	EXPECT_EQ(hamming_code::kQueueFull, coder.TrySubmit(&rejected_job));
+	blocking_job.Release();
+	EXPECT_EQ(hamming_code::kSuccess, coder.Wait(&blocking_job));
+	EXPECT_EQ(hamming_code::kSuccess, coder.Wait(&queued_job));
+	EXPECT_EQ(hamming_code::kSuccess, coder.TrySubmit(&rejected_job));
+	EXPECT_EQ(hamming_code::kSuccess, coder.Wait(&rejected_job));
+
+	vector<hamming_code::Matrix::Value> expected_data(encoded_data.size());
+	EXPECT_EQ(0, hamming_coder_.Encode(&data[0], 4, &expected_data[0]));
+	EXPECT_TRUE(expected_data == encoded_data);
+}
+
+TEST_F(AsyncHammingCoderTest, Decode) {
+	size_t number_jobs = 16;
+	size_t job_length = 3;
+	size_t number_words = number_jobs * job_length;
+	vector<hamming_code::Matrix::Value> data(number_words * 11);
+	for (size_t i = 0; i < data.size(); ++i) {
+		data[i] = (i * 3 + i / 5) % 2;
+	}
+	vector<hamming_code::Matrix::Value> encoded_data(number_words * 15);
+	EXPECT_EQ(0, hamming_coder_.Encode(&data[0], number_words,
+			&encoded_data[0]));
+
+	vector<hamming_code::Matrix::Value> decoded_data(data.size());
+	hamming_code::AsyncHammingCoder coder(&hamming_coder_, 2);
+	vector<hamming_code::AsyncHammingCoder::Job> jobs;
+	for (size_t i = 0; i < number_jobs; ++i) {
+		jobs.push_back(hamming_code::AsyncHammingCoder::Job(
+				hamming_code::AsyncHammingCoder::kDecode,
+				&encoded_data[i * job_length * 15], job_length,
+				&decoded_data[i * job_length * 11]));
+	}
+	for (size_t i = 0; i < number_jobs; ++i) {
+		EXPECT_EQ(hamming_code::kSuccess, coder.Submit(&jobs[i]));
+	}
+	for (size_t i = 0; i < number_jobs; ++i) {
+		EXPECT_EQ(hamming_code::kSuccess, coder.Wait(&jobs[i]));
+	}
+	EXPECT_TRUE(data == decoded_data);
+}
+
+TEST_F(AsyncHammingCoderTest, BatchedCorrectWithUncorrectableWord) {
+	hamming_code::HammingCoder extended_coder;
+	EXPECT_EQ(0, hamming_code::HammingCodeFactory::CreateExtendedCoder(2, 4,
+			&extended_coder));
+	hamming_code::CodingStatistics statistics(16, 2);
+	EXPECT_EQ(hamming_code::kSuccess, extended_coder.SetStatistics(&statistics));
+	size_t number_jobs = 4;
+	size_t job_length = 3;
+	size_t number_words = number_jobs * job_length;
+	vector<hamming_code::Matrix::Value> data(number_words * 11);
+	for (size_t i = 0; i < data.size(); ++i) {
+		data[i] = (i * 7 + i / 3) % 2;
+	}
+	vector<hamming_code::Matrix::Value> expected_data(number_words * 16);
+	EXPECT_EQ(0, extended_coder.Encode(&data[0], number_words,
+			&expected_data[0]));
+
+	// A single error in every word, and a double error in the second word of
+	// job 2.
+	vector<hamming_code::Matrix::Value> received_data(expected_data);
+	for (size_t i = 0; i < number_words; ++i) {
+		received_data[i * 16 + i % 16] ^= 1;
+	}
+	size_t double_error_word = 2 * job_length + 1;
+	received_data[double_error_word * 16 + (double_error_word + 1) % 16] ^= 1;
+
+	vector<hamming_code::Matrix::Value> corrected_data(received_data.size());
+	hamming_code::AsyncHammingCoder coder(&extended_coder, 1);
+	// The correct jobs queue up behind the blocking job, so the worker takes
+	// them together.
+	vector<hamming_code::Matrix::Value> blocking_data(11 + 16);
+	BlockingJob blocking_job(&blocking_data[0], &blocking_data[11]);
+	EXPECT_EQ(hamming_code::kSuccess, coder.Submit(&blocking_job));
+	blocking_job.WaitEntered();
+	vector<hamming_code::AsyncHammingCoder::Job> jobs;
+	for (size_t i = 0; i < number_jobs; ++i) {
+		jobs.push_back(hamming_code::AsyncHammingCoder::Job(
+				hamming_code::AsyncHammingCoder::kCorrect,
+				&received_data[i * job_length * 16], job_length,
+				&corrected_data[i * job_length * 16]));
+	}
+	for (size_t i = 0; i < number_jobs; ++i) {
+		EXPECT_EQ(hamming_code::kSuccess, coder.Submit(&jobs[i]));
+	}
+	blocking_job.Release();
+	EXPECT_EQ(hamming_code::kSuccess, coder.Wait(&blocking_job));
+	for (size_t i = 0; i < number_jobs; ++i) {
+		EXPECT_EQ(i == 2 ? hamming_code::kUncorrectableError :
+				hamming_code::kSuccess, coder.Wait(&jobs[i]));
+	}
+	for (size_t i = 0; i < number_words; ++i) {
+		const hamming_code::Matrix::Value *word = &corrected_data[i * 16];
+		const hamming_code::Matrix::Value *expected_word =
+				i == double_error_word ?
+						&received_data[i * 16] : &expected_data[i * 16];
+		EXPECT_TRUE(std::equal(word, word + 16, expected_word));
+	}
+
+	// Every word is checked once.
+	hamming_code::CodingStatistics::Snapshot snapshot;
+	statistics.GetSnapshot(&snapshot);
+	EXPECT_EQ(number_words, snapshot.number_checked_words);
+	EXPECT_EQ(number_words - 1, snapshot.number_corrected_words);
+	EXPECT_EQ(1u, snapshot.number_uncorrectable_words);
+	EXPECT_EQ(0u, snapshot.number_clean_words);
+}
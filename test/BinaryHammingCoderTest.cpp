@@ -0,0 +1,187 @@
+/*
+ * BinaryHammingCoderTest.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <iostream>
+#include <fstream>
+#include "../src/BinaryHammingCoder.h"
+#include "../src/HammingCoder.h"
+#include "../src/Matrix.h"
+#include "../src/Status.h"
+
+using namespace std;
+
+class BinaryHammingCoderTest: public ::testing::Test {
+protected:
+	virtual void SetUp() {
+		hamming_code::Matrix::Value generator_matrix_data[] = { 1, 1, 0, 1, 1, 0, 1,
+				0, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 0, 1, 1, 1, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 1, 1, 1, 1, 0, 1, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0,
+				0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 };
+		generator_matrix_ = hamming_code::Matrix(15, 11, generator_matrix_data);
+
+		hamming_code::Matrix::Value checker_matrix_data[] = { 1, 0, 1, 0, 1, 0, 1,
+				0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0,
+				1, 1, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0,
+				0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1 };
+		checker_matrix_ = hamming_code::Matrix(4, 15, checker_matrix_data);
+
+		hamming_code::Matrix::Value reciver_matrix_data[] = { 0, 0, 1, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+				0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 };
+		receiver_matrix_ = hamming_code::Matrix(11, 15, reciver_matrix_data);
+
+		hamming_coder_ = hamming_code::HammingCoder(2, generator_matrix_,
+				checker_matrix_, receiver_matrix_);
+		binary_hamming_coder_ = hamming_code::BinaryHammingCoder(
+				generator_matrix_, checker_matrix_, receiver_matrix_);
+	}
+
+	virtual void TearDown() {
+	}
+	hamming_code::Matrix generator_matrix_;
+	hamming_code::Matrix checker_matrix_;
+	hamming_code::Matrix receiver_matrix_;
+	hamming_code::HammingCoder hamming_coder_;
+	hamming_code::BinaryHammingCoder binary_hamming_coder_;
+};
+
+TEST_F(BinaryHammingCoderTest, PackAndUnpack) {
+	hamming_code::Matrix::Value pattern_data[] = { 1, 0, 0, 1, 0, 0, 1, 0, 1, 1, 0 };
+	size_t pattern_size = 11;
+	hamming_code::Matrix pattern(pattern_size, 1, pattern_data);
+	hamming_code::BinaryHammingCoder::Word word = 0;
+	EXPECT_EQ(0, hamming_code::BinaryHammingCoder::Pack(pattern, &word));
+	EXPECT_EQ(0x349u, word);
+
+	hamming_code::Matrix unpacked;
+	EXPECT_EQ(0, hamming_code::BinaryHammingCoder::Unpack(word, pattern_size, &unpacked));
+	EXPECT_EQ(pattern_size, unpacked.GetNumberRows());
+	for (size_t i = 0; i < pattern_size; ++i) {
+		EXPECT_EQ(pattern_data[i], unpacked.GetElement(i, 0));
+	}
+}
+
+TEST_F(BinaryHammingCoderTest, Encode) {
+	EXPECT_EQ(15u, binary_hamming_coder_.GetWordLength());
+	EXPECT_EQ(11u, binary_hamming_coder_.GetDataLength());
+	EXPECT_EQ(4u, binary_hamming_coder_.GetSyndromeLength());
+	for (hamming_code::BinaryHammingCoder::Word data = 0; data < (1 << 11); ++data) {
+		hamming_code::Matrix pattern;
+		hamming_code::BinaryHammingCoder::Unpack(data, 11, &pattern);
+		hamming_code::Matrix encoded_pattern;
+		hamming_coder_.Encode(pattern, &encoded_pattern);
+		hamming_code::BinaryHammingCoder::Word expected = 0;
+		hamming_code::BinaryHammingCoder::Pack(encoded_pattern, &expected);
+
+		hamming_code::BinaryHammingCoder::Word encoded_data = 0;
+		EXPECT_EQ(0, binary_hamming_coder_.Encode(data, &encoded_data));
+		EXPECT_EQ(expected, encoded_data);
+	}
+}
+
+TEST_F(BinaryHammingCoderTest, DecodeOneErrorData) {
+	hamming_code::BinaryHammingCoder::Word data = 0x349;
+	hamming_code::BinaryHammingCoder::Word encoded_data = 0;
+	EXPECT_EQ(0, binary_hamming_coder_.Encode(data, &encoded_data));
+	for (size_t i = 0; i < 15; ++i) {
+		hamming_code::BinaryHammingCoder::Word error_data = encoded_data
+				^ (static_cast<hamming_code::BinaryHammingCoder::Word>(1) << i);
+		hamming_code::BinaryHammingCoder::Word corrected_data = 0;
+		EXPECT_EQ(0, binary_hamming_coder_.Correct(error_data, &corrected_data));
+		EXPECT_EQ(encoded_data, corrected_data);
+
+		hamming_code::BinaryHammingCoder::Word decoded_data = 0;
+		EXPECT_EQ(0, binary_hamming_coder_.Decode(corrected_data, &decoded_data));
+		EXPECT_EQ(data, decoded_data);
+	}
+}
+
+TEST_F(BinaryHammingCoderTest, DecodeMultipleOneErrorWords) {
+	size_t number_words = 15;
+	hamming_code::BinaryHammingCoder::Word data[15];
+	hamming_code::BinaryHammingCoder::Word encoded_data[15];
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		data[word_i] = (word_i * 0x135) & 0x7ff;
+	}
+	EXPECT_EQ(0, binary_hamming_coder_.Encode(data, number_words, encoded_data));
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		hamming_code::BinaryHammingCoder::Word expected = 0;
+		binary_hamming_coder_.Encode(data[word_i], &expected);
+		EXPECT_EQ(expected, encoded_data[word_i]);
+		encoded_data[word_i] ^= static_cast<hamming_code::BinaryHammingCoder::Word>(1) << word_i;
+	}
+
+	hamming_code::BinaryHammingCoder::Word corrected_data[15];
+	EXPECT_EQ(0, binary_hamming_coder_.Correct(encoded_data, number_words, corrected_data));
+	hamming_code::BinaryHammingCoder::Word decoded_data[15];
+	EXPECT_EQ(0, binary_hamming_coder_.Decode(corrected_data, number_words, decoded_data));
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		EXPECT_EQ(data[word_i], decoded_data[word_i]);
+	}
+}
+
+TEST_F(BinaryHammingCoderTest, InitWithInvalidMatrices) {
+	hamming_code::BinaryHammingCoder coder;
+	EXPECT_EQ(0, coder.Init(generator_matrix_, checker_matrix_, receiver_matrix_));
+	EXPECT_EQ(15u, coder.GetWordLength());
+
+	hamming_code::Matrix long_generator_matrix(65, 11);
+	hamming_code::Matrix long_checker_matrix(4, 65);
+	hamming_code::Matrix long_receiver_matrix(11, 65);
+	EXPECT_EQ(hamming_code::kInvalidArgument, coder.Init(long_generator_matrix,
+			long_checker_matrix, long_receiver_matrix));
+	EXPECT_EQ(0u, coder.GetWordLength());
+	EXPECT_EQ(hamming_code::kInvalidArgument, coder.Init(generator_matrix_,
+			checker_matrix_, generator_matrix_));
+	hamming_code::Matrix tall_checker_matrix(17, 15);
+	EXPECT_EQ(hamming_code::kInvalidArgument, coder.Init(generator_matrix_,
+			tall_checker_matrix, receiver_matrix_));
+
+	hamming_code::BinaryHammingCoder::Word corrected_data = 1;
+	EXPECT_EQ(0, coder.Correct(0, &corrected_data));
+	EXPECT_EQ(0u, corrected_data);
+}
@@ -0,0 +1,146 @@
+/*
+ * BitSlicedHammingCoderTest.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <iostream>
+#include <fstream>
+#include "../src/BinaryHammingCoder.h"
+#include "../src/BitSlicedHammingCoder.h"
+#include "../src/Matrix.h"
+
+using namespace std;
+
+class BitSlicedHammingCoderTest: public ::testing::Test {
+protected:
+	virtual void SetUp() {
+		hamming_code::Matrix::Value generator_matrix_data[] = { 1, 1, 0, 1, 1, 0, 1,
+				0, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 0, 1, 1, 1, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 1, 1, 1, 1, 0, 1, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0,
+				0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 };
+		generator_matrix_ = hamming_code::Matrix(15, 11, generator_matrix_data);
+
+		hamming_code::Matrix::Value checker_matrix_data[] = { 1, 0, 1, 0, 1, 0, 1,
+				0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0,
+				1, 1, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0,
+				0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1 };
+		checker_matrix_ = hamming_code::Matrix(4, 15, checker_matrix_data);
+
+		hamming_code::Matrix::Value reciver_matrix_data[] = { 0, 0, 1, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+				0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 };
+		receiver_matrix_ = hamming_code::Matrix(11, 15, reciver_matrix_data);
+
+		binary_hamming_coder_ = hamming_code::BinaryHammingCoder(
+				generator_matrix_, checker_matrix_, receiver_matrix_);
+		bit_sliced_hamming_coder_ = hamming_code::BitSlicedHammingCoder(
+				generator_matrix_, checker_matrix_, receiver_matrix_);
+	}
+
+	virtual void TearDown() {
+	}
+	hamming_code::Matrix generator_matrix_;
+	hamming_code::Matrix checker_matrix_;
+	hamming_code::Matrix receiver_matrix_;
+	hamming_code::BinaryHammingCoder binary_hamming_coder_;
+	hamming_code::BitSlicedHammingCoder bit_sliced_hamming_coder_;
+};
+
+TEST_F(BitSlicedHammingCoderTest, SliceAndUnslice) {
+	size_t number_words = 600;
+	vector<hamming_code::BitSlicedHammingCoder::Word> words(number_words);
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		words[word_i] = (word_i * 0x2b5) & 0x7fff;
+	}
+	size_t number_blocks = hamming_code::BitSlicedHammingCoder::GetNumberBlocks(number_words);
+	EXPECT_EQ(2u, number_blocks);
+	vector<hamming_code::BitSlicedHammingCoder::Word> slices(
+			number_blocks * 15 * hamming_code::BitSlicedHammingCoder::kSliceLength);
+	EXPECT_EQ(0, hamming_code::BitSlicedHammingCoder::Slice(&words[0], number_words, 15, &slices[0]));
+	EXPECT_EQ(0x2u, slices[0] & 0x3);
+	vector<hamming_code::BitSlicedHammingCoder::Word> unsliced(number_words);
+	EXPECT_EQ(0, hamming_code::BitSlicedHammingCoder::Unslice(&slices[0], number_words, 15, &unsliced[0]));
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		EXPECT_EQ(words[word_i], unsliced[word_i]);
+	}
+}
+
+TEST_F(BitSlicedHammingCoderTest, DecodeOneErrorDataForEachInstructionSet) {
+	typedef hamming_code::BitSlicedHammingCoder::Word Word;
+	size_t number_words = 1000;
+	vector<Word> data(number_words);
+	vector<Word> expected_encoded_data(number_words);
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		data[word_i] = (word_i * 0x135) & 0x7ff;
+		binary_hamming_coder_.Encode(data[word_i], &expected_encoded_data[word_i]);
+	}
+	size_t number_blocks = hamming_code::BitSlicedHammingCoder::GetNumberBlocks(number_words);
+	size_t slice_length = hamming_code::BitSlicedHammingCoder::kSliceLength;
+	vector<Word> data_slices(number_blocks * 11 * slice_length);
+	hamming_code::BitSlicedHammingCoder::Slice(&data[0], number_words, 11, &data_slices[0]);
+
+	hamming_code::BitSlicedHammingCoder::InstructionSet supported =
+			hamming_code::BitSlicedHammingCoder::GetSupportedInstructionSet();
+	EXPECT_EQ(supported, bit_sliced_hamming_coder_.GetInstructionSet());
+	for (int instruction_set = hamming_code::BitSlicedHammingCoder::kScalar;
+			instruction_set <= supported; ++instruction_set) {
+		EXPECT_EQ(0, bit_sliced_hamming_coder_.SetInstructionSet(
+				static_cast<hamming_code::BitSlicedHammingCoder::InstructionSet>(instruction_set)));
+		vector<Word> encoded_slices(number_blocks * 15 * slice_length);
+		EXPECT_EQ(0, bit_sliced_hamming_coder_.Encode(&data_slices[0], number_blocks, &encoded_slices[0]));
+		vector<Word> encoded_data(number_words);
+		hamming_code::BitSlicedHammingCoder::Unslice(&encoded_slices[0], number_words, 15, &encoded_data[0]);
+		for (size_t word_i = 0; word_i < number_words; ++word_i) {
+			EXPECT_EQ(expected_encoded_data[word_i], encoded_data[word_i]);
+			encoded_data[word_i] ^= static_cast<Word>(1) << (word_i % 15);
+		}
+
+		hamming_code::BitSlicedHammingCoder::Slice(&encoded_data[0], number_words, 15, &encoded_slices[0]);
+		vector<Word> corrected_slices(number_blocks * 15 * slice_length);
+		EXPECT_EQ(0, bit_sliced_hamming_coder_.Correct(&encoded_slices[0], number_blocks, &corrected_slices[0]));
+		vector<Word> decoded_slices(number_blocks * 11 * slice_length);
+		EXPECT_EQ(0, bit_sliced_hamming_coder_.Decode(&corrected_slices[0], number_blocks, &decoded_slices[0]));
+		EXPECT_TRUE(data_slices == decoded_slices);
+	}
+}
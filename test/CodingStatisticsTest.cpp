@@ -0,0 +1,150 @@
+/*
+ * CodingStatisticsTest.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <vector>
+#include "../src/CodingStatistics.h"
+#include "../src/HammingCodeFactory.h"
+#include "../src/HammingCoder.h"
+#include "../src/Matrix.h"
+#include "../src/Status.h"
+
+using namespace std;
+
+class CodingStatisticsTest: public ::testing::Test {
+protected:
+	virtual void SetUp() {
+		hamming_code::HammingCodeFactory::CreateCoder(2, 3, &hamming_coder_);
+	}
+
+	virtual void TearDown() {
+	}
+	hamming_code::HammingCoder hamming_coder_;
+};
+
+TEST_F(CodingStatisticsTest, CountCorrections) {
+	hamming_code::CodingStatistics statistics(7, 2, true);
+	hamming_code::CodingStatistics other_statistics(15, 2);
+	EXPECT_EQ(hamming_code::kInvalidArgument,
+			hamming_coder_.SetStatistics(&other_statistics));
+	EXPECT_EQ(hamming_code::kSuccess, hamming_coder_.SetStatistics(&statistics));
+
+	size_t number_words = 4;
+	vector<hamming_code::Matrix::Value> data(number_words * 4);
+	for (size_t i = 0; i < data.size(); ++i) {
+		data[i] = (i * 3 + i / 5) % 2;
+	}
+	vector<hamming_code::Matrix::Value> encoded_data(number_words * 7);
+	EXPECT_EQ(0, hamming_coder_.Encode(&data[0], number_words, &encoded_data[0]));
+	encoded_data[7 + 2] ^= 1;
+	encoded_data[21 + 5] ^= 1;
+	EXPECT_EQ(0, hamming_coder_.Correct(&encoded_data[0], number_words));
+	vector<hamming_code::Matrix::Value> decoded_data(data.size());
+	EXPECT_EQ(0, hamming_coder_.Decode(&encoded_data[0], number_words,
+			&decoded_data[0]));
+	EXPECT_TRUE(data == decoded_data);
+	vector<size_t> dirty_words;
+	EXPECT_EQ(0, hamming_coder_.Verify(&encoded_data[0], number_words,
+			&dirty_words));
+	EXPECT_TRUE(dirty_words.empty());
+
+	hamming_code::CodingStatistics::Snapshot snapshot;
+	statistics.GetSnapshot(&snapshot);
+	EXPECT_EQ(4u, snapshot.number_encoded_words);
+	EXPECT_EQ(4u, snapshot.number_checked_words);
+	EXPECT_EQ(4u, snapshot.number_decoded_words);
+	EXPECT_EQ(4u, snapshot.number_verified_words);
+	EXPECT_EQ(2u, snapshot.number_clean_words);
+	EXPECT_EQ(2u, snapshot.number_corrected_words);
+	EXPECT_EQ(0u, snapshot.number_uncorrectable_words);
+	ASSERT_EQ(7u, snapshot.error_positions.size());
+	for (size_t i = 0; i < 7; ++i) {
+		EXPECT_EQ(i == 2 || i == 5 ? 1u : 0u, snapshot.error_positions[i]);
+	}
+	ASSERT_EQ(2u, snapshot.error_values.size());
+	EXPECT_EQ(0u, snapshot.error_values[0]);
+	EXPECT_EQ(2u, snapshot.error_values[1]);
+	for (size_t operation_i = 0;
+			operation_i < hamming_code::CodingStatistics::kNumberOperations;
+			++operation_i) {
+		const vector<uint64_t> &latencies = snapshot.latencies[operation_i];
+		ASSERT_EQ(hamming_code::CodingStatistics::kNumberLatencyBuckets,
+				latencies.size());
+		uint64_t number_calls = 0;
+		for (size_t i = 0; i < latencies.size(); ++i) {
+			number_calls += latencies[i];
+		}
+		EXPECT_EQ(1u, number_calls);
+	}
+
+	statistics.Reset();
+	EXPECT_EQ(hamming_code::kSuccess, hamming_coder_.SetStatistics(NULL));
+	EXPECT_EQ(0, hamming_coder_.Encode(&data[0], number_words, &encoded_data[0]));
+	statistics.GetSnapshot(&snapshot);
+	EXPECT_EQ(0u, snapshot.number_encoded_words);
+	EXPECT_EQ(0u, snapshot.number_corrected_words);
+	EXPECT_EQ(0u, snapshot.error_positions[2]);
+}
+
+TEST_F(CodingStatisticsTest, CountErasureCorrections) {
+	hamming_code::CodingStatistics statistics(7, 2);
+	EXPECT_EQ(hamming_code::kSuccess, hamming_coder_.SetStatistics(&statistics));
+
+	size_t number_words = 3;
+	vector<hamming_code::Matrix::Value> data(number_words * 4, 1);
+	vector<hamming_code::Matrix::Value> encoded_data(number_words * 7);
+	EXPECT_EQ(0, hamming_coder_.Encode(&data[0], number_words, &encoded_data[0]));
+	vector<hamming_code::Matrix::Value> expected_data(encoded_data);
+	// Two erased errors in word 1.
+	vector<uint8_t> erasures(encoded_data.size(), 0);
+	erasures[7 + 1] = 1;
+	erasures[7 + 4] = 1;
+	encoded_data[7 + 1] ^= 1;
+	encoded_data[7 + 4] ^= 1;
+	EXPECT_EQ(hamming_code::kSuccess, hamming_coder_.CorrectErasures(
+			&encoded_data[0], number_words, &erasures[0]));
+	EXPECT_TRUE(expected_data == encoded_data);
+
+	hamming_code::CodingStatistics::Snapshot snapshot;
+	statistics.GetSnapshot(&snapshot);
+	EXPECT_EQ(3u, snapshot.number_checked_words);
+	EXPECT_EQ(2u, snapshot.number_clean_words);
+	EXPECT_EQ(1u, snapshot.number_corrected_words);
+	for (size_t i = 0; i < 7; ++i) {
+		EXPECT_EQ(i == 1 || i == 4 ? 1u : 0u, snapshot.error_positions[i]);
+	}
+	EXPECT_EQ(2u, snapshot.error_values[1]);
+	EXPECT_EQ(hamming_code::kSuccess, hamming_coder_.SetStatistics(NULL));
+}
@@ -0,0 +1,92 @@
+/*
+ * FixedHammingCoderTest.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <iostream>
+#include <fstream>
+#include "../src/BinaryHammingCoder.h"
+#include "../src/FixedHammingCoder.h"
+#include "../src/Matrix.h"
+
+using namespace std;
+
+namespace {
+template<typename Coder>
+void CheckWithBinaryHammingCoder() {
+	typedef typename Coder::Word Word;
+	hamming_code::Matrix generator_matrix;
+	hamming_code::Matrix checker_matrix;
+	hamming_code::Matrix receiver_matrix;
+	EXPECT_EQ(0, Coder::GetMatrices(&generator_matrix, &checker_matrix, &receiver_matrix));
+	hamming_code::BinaryHammingCoder binary_hamming_coder(generator_matrix,
+			checker_matrix, receiver_matrix);
+	Coder coder;
+	Word data_mask = ~static_cast<Word>(0) >> (64 - Coder::kDataLength);
+	Word data = 0x0123456789abcdefULL;
+	for (size_t i = 0; i < 1000; ++i) {
+		data = data * 6364136223846793005ULL + 1442695040888963407ULL;
+		Word encoded_data = 0;
+		EXPECT_EQ(0, coder.Encode(data & data_mask, &encoded_data));
+		Word expected = 0;
+		binary_hamming_coder.Encode(data & data_mask, &expected);
+		EXPECT_EQ(expected, encoded_data);
+
+		Word error_data = encoded_data ^ (static_cast<Word>(1) << (i % Coder::kWordLength));
+		Word corrected_data = 0;
+		EXPECT_EQ(0, coder.Correct(error_data, &corrected_data));
+		EXPECT_EQ(encoded_data, corrected_data);
+		EXPECT_EQ(0, coder.Correct(encoded_data, &corrected_data));
+		EXPECT_EQ(encoded_data, corrected_data);
+
+		Word decoded_data = 0;
+		EXPECT_EQ(0, coder.Decode(corrected_data, &decoded_data));
+		EXPECT_EQ(data & data_mask, decoded_data);
+	}
+}
+}
+
+TEST(FixedHammingCoderTest, Encode) {
+	hamming_code::HammingCoder15_11 coder;
+	hamming_code::HammingCoder15_11::Word encoded_data = 0;
+	EXPECT_EQ(0, coder.Encode(0x349, &encoded_data));
+	EXPECT_EQ(0x34ccu, encoded_data);
+}
+
+TEST(FixedHammingCoderTest, StandardCodes) {
+	CheckWithBinaryHammingCoder<hamming_code::HammingCoder7_4>();
+	CheckWithBinaryHammingCoder<hamming_code::HammingCoder15_11>();
+	CheckWithBinaryHammingCoder<hamming_code::HammingCoder31_26>();
+	CheckWithBinaryHammingCoder<hamming_code::HammingCoder63_57>();
+}
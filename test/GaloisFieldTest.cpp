@@ -0,0 +1,76 @@
+/*
+ * GaloisFieldTest.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include "../src/GaloisField.h"
+
+using namespace std;
+
+class GaloisFieldTest: public ::testing::Test {
+protected:
+	virtual void SetUp() {
+	}
+
+	virtual void TearDown() {
+	}
+};
+
+TEST_F(GaloisFieldTest, ReduceMatchesModulo) {
+	uint8_t orders[] = { 2, 3, 5, 7, 13, 127 };
+	for (size_t order_i = 0; order_i < sizeof(orders) / sizeof(orders[0]); ++order_i) {
+		uint32_t order = orders[order_i];
+		hamming_code::GaloisField field(order);
+		for (uint32_t value = 0; value < 100000; ++value) {
+			EXPECT_EQ(static_cast<int>(value % order), field.Reduce(value));
+		}
+		EXPECT_EQ(static_cast<int>(0xffffffffU % order), field.Reduce(0xffffffffU));
+	}
+}
+
+TEST_F(GaloisFieldTest, ElementArithmetic) {
+	hamming_code::GaloisField field(7);
+	for (int a = 0; a < 7; ++a) {
+		for (int b = 0; b < 7; ++b) {
+			EXPECT_EQ((a + b) % 7, field.Add(a, b));
+			EXPECT_EQ((a - b + 7) % 7, field.Subtract(a, b));
+			EXPECT_EQ((a * b) % 7, field.Multiply(a, b));
+		}
+		if (a != 0) {
+			EXPECT_EQ(1, field.Multiply(a, field.Inverse(a)));
+		}
+	}
+	EXPECT_EQ(4, field.Normalize(-3));
+	EXPECT_EQ(1, field.Normalize(15));
+}
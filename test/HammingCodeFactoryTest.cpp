@@ -0,0 +1,247 @@
+/*
+ * HammingCodeFactoryTest.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <vector>
+#include "../src/BinaryHammingCoder.h"
+#include "../src/HammingCodeFactory.h"
+#include "../src/HammingCoder.h"
+#include "../src/Matrix.h"
+#include "../src/MatrixView.h"
+#include "../src/Status.h"
+
+using namespace std;
+
+namespace {
+void CheckCode(uint8_t alphabet_size, size_t redundancy, size_t word_length) {
+	hamming_code::Matrix generator_matrix;
+	hamming_code::Matrix checker_matrix;
+	hamming_code::Matrix receiver_matrix;
+	EXPECT_EQ(0, hamming_code::HammingCodeFactory::CreateMatrices(alphabet_size,
+			redundancy, &generator_matrix, &checker_matrix, &receiver_matrix));
+	size_t data_length = word_length - redundancy;
+	EXPECT_EQ(word_length, generator_matrix.GetNumberRows());
+	EXPECT_EQ(data_length, generator_matrix.GetNumberColums());
+	EXPECT_EQ(redundancy, checker_matrix.GetNumberRows());
+
+	hamming_code::Matrix product;
+	hamming_code::Matrix::Multiply(checker_matrix, generator_matrix, &product);
+	for (size_t row_i = 0; row_i < redundancy; ++row_i) {
+		for (size_t column_i = 0; column_i < data_length; ++column_i) {
+			EXPECT_EQ(0, product.GetElement(row_i, column_i) % alphabet_size);
+		}
+	}
+
+	hamming_code::HammingCoder coder;
+	EXPECT_EQ(0, hamming_code::HammingCodeFactory::CreateCoder(alphabet_size,
+			redundancy, &coder));
+	vector<hamming_code::Matrix::Value> data(data_length);
+	for (size_t i = 0; i < data_length; ++i) {
+		data[i] = (i * 7 + 3) % alphabet_size;
+	}
+	vector<hamming_code::Matrix::Value> encoded_data(word_length);
+	EXPECT_EQ(0, coder.Encode(&data[0], 1, &encoded_data[0]));
+	for (size_t i = 0; i < data_length; ++i) {
+		EXPECT_EQ(data[i], encoded_data[i]);
+	}
+	for (size_t position = 0; position < word_length; ++position) {
+		for (hamming_code::Matrix::Value error = 1; error < alphabet_size; ++error) {
+			vector<hamming_code::Matrix::Value> error_data(encoded_data);
+			error_data[position] = (error_data[position] + error) % alphabet_size;
+			vector<hamming_code::Matrix::Value> corrected_data(word_length);
+			EXPECT_EQ(0, coder.Correct(&error_data[0], 1, &corrected_data[0]));
+			EXPECT_TRUE(encoded_data == corrected_data);
+			vector<hamming_code::Matrix::Value> decoded_data(data_length);
+			EXPECT_EQ(0, coder.Decode(&corrected_data[0], 1, &decoded_data[0]));
+			EXPECT_TRUE(data == decoded_data);
+			EXPECT_EQ(0, coder.CorrectAndDecode(&error_data[0], 1, &decoded_data[0]));
+			EXPECT_TRUE(data == decoded_data);
+			hamming_code::MatrixView error_view(word_length, 1, &error_data[0]);
+			vector<size_t> dirty_words;
+			EXPECT_EQ(0, coder.Verify(error_view, &dirty_words));
+			EXPECT_EQ(1u, dirty_words.size());
+		}
+	}
+
+	for (size_t position0 = 0; position0 < word_length; ++position0) {
+		for (size_t position1 = position0 + 1; position1 < word_length;
+				++position1) {
+			vector<hamming_code::Matrix::Value> error_data(encoded_data);
+			error_data[position0] = (error_data[position0] + position1)
+					% alphabet_size;
+			error_data[position1] = (error_data[position1] + 1) % alphabet_size;
+			vector<uint8_t> erasures(word_length, 0);
+			erasures[position0] = 1;
+			erasures[position1] = 1;
+			EXPECT_EQ(0, coder.CorrectErasures(&error_data[0], 1, &erasures[0]));
+			EXPECT_TRUE(encoded_data == error_data);
+			// A reliable symbol marked erased and an error elsewhere.
+			error_data[position1] = (error_data[position1] + 1) % alphabet_size;
+			erasures[position1] = 0;
+			EXPECT_EQ(0, coder.CorrectErasures(&error_data[0], 1, &erasures[0]));
+			EXPECT_TRUE(encoded_data == error_data);
+		}
+	}
+	if (word_length >= 3) {
+		vector<hamming_code::Matrix::Value> error_data(encoded_data);
+		error_data[0] = (error_data[0] + 1) % alphabet_size;
+		vector<hamming_code::Matrix::Value> received_data(error_data);
+		vector<uint8_t> erasures(word_length, 1);
+		EXPECT_EQ(hamming_code::kUncorrectableError,
+				coder.CorrectErasures(&error_data[0], 1, &erasures[0]));
+		EXPECT_TRUE(received_data == error_data);
+	}
+
+	EXPECT_EQ(0, coder.SetEngine(hamming_code::HammingCoder::kTableEngine));
+	vector<hamming_code::Matrix::Value> table_encoded_data(word_length);
+	EXPECT_EQ(0, coder.Encode(&data[0], 1, &table_encoded_data[0]));
+	EXPECT_TRUE(encoded_data == table_encoded_data);
+	for (size_t position = 0; position < word_length; ++position) {
+		vector<hamming_code::Matrix::Value> error_data(encoded_data);
+		error_data[position] = (error_data[position] + 1) % alphabet_size;
+		EXPECT_EQ(0, coder.Correct(&error_data[0], 1));
+		EXPECT_TRUE(encoded_data == error_data);
+	}
+
+	hamming_code::Matrix encoded_matrix(word_length, 1, &encoded_data[0]);
+	hamming_code::Matrix decoded_matrix;
+	EXPECT_EQ(0, coder.Decode(encoded_matrix, &decoded_matrix));
+	for (size_t i = 0; i < data_length; ++i) {
+		EXPECT_EQ(data[i], decoded_matrix.GetElement(i, 0));
+	}
+}
+}
+
+TEST(HammingCodeFactoryTest, BinaryCodes) {
+	CheckCode(2, 2, 3);
+	CheckCode(2, 3, 7);
+	CheckCode(2, 4, 15);
+	CheckCode(2, 6, 63);
+}
+
+TEST(HammingCodeFactoryTest, TernaryAndQuinaryCodes) {
+	CheckCode(3, 2, 4);
+	CheckCode(3, 3, 13);
+	CheckCode(5, 2, 6);
+	CheckCode(5, 3, 31);
+	CheckCode(7, 2, 8);
+}
+
+TEST(HammingCodeFactoryTest, InvalidParameters) {
+	hamming_code::Matrix generator_matrix;
+	hamming_code::Matrix checker_matrix;
+	hamming_code::Matrix receiver_matrix;
+	EXPECT_EQ(1, hamming_code::HammingCodeFactory::CreateMatrices(4, 3,
+			&generator_matrix, &checker_matrix, &receiver_matrix));
+	EXPECT_EQ(1, hamming_code::HammingCodeFactory::CreateMatrices(2, 1,
+			&generator_matrix, &checker_matrix, &receiver_matrix));
+	// Symbols of 131 do not fit in a Matrix::Value.
+	EXPECT_EQ(hamming_code::kInvalidArgument,
+			hamming_code::HammingCodeFactory::CreateMatrices(131, 2,
+					&generator_matrix, &checker_matrix, &receiver_matrix));
+	EXPECT_EQ(hamming_code::kSuccess,
+			hamming_code::HammingCodeFactory::CreateMatrices(127, 2,
+					&generator_matrix, &checker_matrix, &receiver_matrix));
+	EXPECT_EQ(128u, generator_matrix.GetNumberRows());
+	// q^r over kMaxNumberSyndromes, also where q^r overflows a size_t.
+	EXPECT_EQ(hamming_code::kInvalidArgument,
+			hamming_code::HammingCodeFactory::CreateMatrices(127, 3,
+					&generator_matrix, &checker_matrix, &receiver_matrix));
+	EXPECT_EQ(hamming_code::kInvalidArgument,
+			hamming_code::HammingCodeFactory::CreateMatrices(2, 15,
+					&generator_matrix, &checker_matrix, &receiver_matrix));
+	EXPECT_EQ(hamming_code::kInvalidArgument,
+			hamming_code::HammingCodeFactory::CreateMatrices(2, 100,
+					&generator_matrix, &checker_matrix, &receiver_matrix));
+}
+
+TEST(HammingCodeFactoryTest, ExtendedCodeDetectsDoubleErrors) {
+	hamming_code::Matrix generator_matrix;
+	hamming_code::Matrix checker_matrix;
+	hamming_code::Matrix receiver_matrix;
+	EXPECT_EQ(0, hamming_code::HammingCodeFactory::CreateExtendedMatrices(2, 4,
+			&generator_matrix, &checker_matrix, &receiver_matrix));
+	EXPECT_EQ(16u, generator_matrix.GetNumberRows());
+	EXPECT_EQ(5u, checker_matrix.GetNumberRows());
+	hamming_code::HammingCoder coder(2, generator_matrix, checker_matrix,
+			receiver_matrix);
+	hamming_code::BinaryHammingCoder binary_coder(generator_matrix,
+			checker_matrix, receiver_matrix);
+
+	hamming_code::Matrix::Value data[] = { 1, 0, 0, 1, 0, 0, 1, 0, 1, 1, 0 };
+	hamming_code::Matrix::Value encoded_data[16];
+	EXPECT_EQ(0, coder.Encode(data, 1, encoded_data));
+	hamming_code::Matrix encoded_matrix(16, 1, encoded_data);
+	hamming_code::BinaryHammingCoder::Word encoded_word = 0;
+	hamming_code::BinaryHammingCoder::Pack(encoded_matrix, &encoded_word);
+	for (size_t position0 = 0; position0 < 16; ++position0) {
+		for (size_t position1 = position0; position1 < 16; ++position1) {
+			hamming_code::Matrix::Value error_data[16];
+			std::copy(encoded_data, encoded_data + 16, error_data);
+			error_data[position0] ^= 1;
+			hamming_code::BinaryHammingCoder::Word error_word = encoded_word
+					^ (static_cast<hamming_code::BinaryHammingCoder::Word>(1) << position0);
+			if (position1 != position0) {
+				error_data[position1] ^= 1;
+				error_word ^= static_cast<hamming_code::BinaryHammingCoder::Word>(1) << position1;
+			}
+			hamming_code::Matrix::Value corrected_data[16];
+			int ret = coder.Correct(error_data, 1, corrected_data);
+			hamming_code::BinaryHammingCoder::Word corrected_word = 0;
+			int binary_ret = binary_coder.Correct(error_word, &corrected_word);
+			if (position1 == position0) {
+				EXPECT_EQ(hamming_code::kSuccess, ret);
+				EXPECT_EQ(hamming_code::kSuccess, binary_ret);
+				for (size_t i = 0; i < 16; ++i) {
+					EXPECT_EQ(encoded_data[i], corrected_data[i]);
+				}
+				EXPECT_EQ(encoded_word, corrected_word);
+			} else {
+				EXPECT_EQ(hamming_code::kUncorrectableError, ret);
+				EXPECT_EQ(hamming_code::kUncorrectableError, binary_ret);
+				for (size_t i = 0; i < 16; ++i) {
+					EXPECT_EQ(error_data[i], corrected_data[i]);
+				}
+				EXPECT_EQ(error_word, corrected_word);
+			}
+		}
+	}
+	EXPECT_EQ(hamming_code::kInvalidArgument,
+			hamming_code::HammingCodeFactory::CreateExtendedMatrices(3, 2,
+					&generator_matrix, &checker_matrix, &receiver_matrix));
+}
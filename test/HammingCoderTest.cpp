@@ -33,14 +33,69 @@
  */
 
 #include <gtest/gtest.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <iostream>
 #include <fstream>
+#include <string>
+#include <vector>
+#include <pthread.h>
 #include "../src/HammingCoder.h"
 #include "../src/Matrix.h"
+#include "../src/Status.h"
 
 using namespace std;
 
+namespace {
+struct SharedCoderThread {
+	const hamming_code::HammingCoder *coder;
+	size_t seed;
+	int number_failures;
+};
+
+void *RunSharedCoderThread(void *argument) {
+	SharedCoderThread *thread = static_cast<SharedCoderThread *>(argument);
+	const hamming_code::HammingCoder &coder = *thread->coder;
+	size_t number_words = 64;
+	vector<hamming_code::Matrix::Value> data(11 * number_words);
+	vector<hamming_code::Matrix::Value> encoded_data(15 * number_words);
+	vector<hamming_code::Matrix::Value> decoded_data(data.size());
+	hamming_code::MatrixArena arena;
+	for (size_t round = 0; round < 200; ++round) {
+		for (size_t i = 0; i < data.size(); ++i) {
+			data[i] = ((i + thread->seed) * 7 + round) % 3 == 0;
+		}
+		coder.Encode(&data[0], number_words, &encoded_data[0]);
+		vector<hamming_code::Matrix::Value> error_data(encoded_data);
+		for (size_t word_i = 0; word_i < number_words; ++word_i) {
+			error_data[word_i * 15 + (word_i + round) % 15] ^= 1;
+		}
+		thread->number_failures += coder.CorrectAndDecode(&error_data[0],
+				number_words, &decoded_data[0]) != 0 || decoded_data != data;
+		arena.Reset();
+		hamming_code::MatrixView words(15, number_words, &error_data[0]);
+		thread->number_failures += coder.Correct(words, &words, &arena) != 0;
+	}
+	return NULL;
+}
+
+uint64_t ReadImageField(const std::string &path, size_t offset) {
+	std::ifstream file(path.c_str(), std::ios::binary);
+	uint64_t value = 0;
+	file.seekg(offset);
+	file.read(reinterpret_cast<char *>(&value), sizeof(value));
+	return value;
+}
+
+void WriteImageField(const std::string &path, size_t offset, uint64_t value) {
+	std::fstream file(path.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+	file.seekp(offset);
+	file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+}
+
+#define IMAGE_FIELD(field) offsetof(hamming_code::HammingCoder::ImageHeader, field)
+
 class HammingCoderTest: public ::testing::Test {
 protected:
 	virtual void SetUp() {
@@ -132,3 +187,301 @@ TEST_F(HammingCoderTest, DecodeOneErrorData) {
 	}
 }
 
+TEST_F(HammingCoderTest, EncodeMultipleWords) {
+	size_t pattern_size = 11;
+	size_t number_words = 3;
+	hamming_code::Matrix::Value pattern_data[] = {
+			1, 0, 0, 1, 0, 0, 1, 0, 1, 1, 0,
+			0, 1, 1, 0, 1, 0, 0, 0, 1, 0, 1,
+			1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+	hamming_code::Matrix patterns(pattern_size, number_words);
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		for (size_t i = 0; i < pattern_size; ++i) {
+			patterns.SetElement(i, word_i, pattern_data[word_i * pattern_size + i]);
+		}
+	}
+	hamming_code::Matrix encoded_patterns;
+	EXPECT_EQ(0, hamming_coder_.Encode(patterns, &encoded_patterns));
+	EXPECT_EQ(number_words, encoded_patterns.GetNumberColums());
+
+	hamming_code::Matrix::Value encoded_data[15 * 3];
+	EXPECT_EQ(0, hamming_coder_.Encode(pattern_data, number_words, encoded_data));
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		hamming_code::Matrix pattern(pattern_size, 1, pattern_data + word_i * pattern_size);
+		hamming_code::Matrix encoded_pattern;
+		hamming_coder_.Encode(pattern, &encoded_pattern);
+		for (size_t i = 0; i < 15; ++i) {
+			EXPECT_EQ(encoded_pattern.GetElement(i, 0), encoded_patterns.GetElement(i, word_i));
+			EXPECT_EQ(encoded_pattern.GetElement(i, 0), encoded_data[word_i * 15 + i]);
+		}
+	}
+}
+
+TEST_F(HammingCoderTest, DecodeMultipleOneErrorWords) {
+	size_t pattern_size = 11;
+	size_t number_words = 3;
+	hamming_code::Matrix::Value pattern_data[] = {
+			1, 0, 0, 1, 0, 0, 1, 0, 1, 1, 0,
+			0, 1, 1, 0, 1, 0, 0, 0, 1, 0, 1,
+			1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+	hamming_code::Matrix::Value encoded_data[15 * 3];
+	EXPECT_EQ(0, hamming_coder_.Encode(pattern_data, number_words, encoded_data));
+	encoded_data[0 * 15 + 0] ^= 1;
+	encoded_data[2 * 15 + 7] ^= 1;
+
+	hamming_code::Matrix encoded_patterns(15, number_words);
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		for (size_t i = 0; i < 15; ++i) {
+			encoded_patterns.SetElement(i, word_i, encoded_data[word_i * 15 + i]);
+		}
+	}
+	hamming_code::Matrix corrected_patterns;
+	EXPECT_EQ(0, hamming_coder_.Correct(encoded_patterns, &corrected_patterns));
+	hamming_code::Matrix decoded_patterns;
+	EXPECT_EQ(0, hamming_coder_.Decode(corrected_patterns, &decoded_patterns));
+
+	hamming_code::Matrix::Value corrected_data[15 * 3];
+	EXPECT_EQ(0, hamming_coder_.Correct(encoded_data, number_words, corrected_data));
+	hamming_code::Matrix::Value decoded_data[11 * 3];
+	EXPECT_EQ(0, hamming_coder_.Decode(corrected_data, number_words, decoded_data));
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		for (size_t i = 0; i < pattern_size; ++i) {
+			EXPECT_EQ(pattern_data[word_i * pattern_size + i], decoded_patterns.GetElement(i, word_i));
+			EXPECT_EQ(pattern_data[word_i * pattern_size + i], decoded_data[word_i * pattern_size + i]);
+		}
+	}
+}
+
+TEST_F(HammingCoderTest, CorrectEachErrorPosition) {
+	hamming_code::Matrix::Value pattern_data[] = { 1, 0, 0, 1, 0, 0, 1, 0, 1, 1, 0 };
+	hamming_code::Matrix::Value encoded_data[15];
+	EXPECT_EQ(0, hamming_coder_.Encode(pattern_data, 1, encoded_data));
+	for (size_t error_position = 0; error_position < 15; ++error_position) {
+		hamming_code::Matrix::Value error_data[15];
+		std::copy(encoded_data, encoded_data + 15, error_data);
+		error_data[error_position] ^= 1;
+		hamming_code::Matrix::Value corrected_data[15];
+		EXPECT_EQ(0, hamming_coder_.Correct(error_data, 1, corrected_data));
+		for (size_t i = 0; i < 15; ++i) {
+			EXPECT_EQ(encoded_data[i], corrected_data[i]);
+		}
+	}
+}
+
+
+TEST_F(HammingCoderTest, CorrectViewInPlaceWithArena) {
+	size_t number_words = 2;
+	hamming_code::Matrix::Value pattern_data[] = {
+			1, 0,
+			0, 1,
+			0, 1,
+			1, 0,
+			0, 1,
+			0, 0,
+			1, 0,
+			0, 0,
+			1, 1,
+			1, 0,
+			0, 1 };
+	hamming_code::MatrixView pattern(11, number_words, pattern_data);
+	hamming_code::Matrix::Value encoded_data[15 * 2];
+	hamming_code::MatrixView encoded(15, number_words, encoded_data);
+	EXPECT_EQ(0, hamming_coder_.Encode(pattern, &encoded));
+	encoded.SetElement(3, 0, encoded.GetElement(3, 0) ^ 1);
+	encoded.SetElement(14, 1, encoded.GetElement(14, 1) ^ 1);
+
+	hamming_code::MatrixArena arena;
+	EXPECT_EQ(0, hamming_coder_.Correct(encoded, &encoded, &arena));
+	hamming_code::Matrix::Value decoded_data[11 * 2];
+	hamming_code::MatrixView decoded(11, number_words, decoded_data);
+	EXPECT_EQ(0, hamming_coder_.Decode(encoded, &decoded));
+	for (size_t i = 0; i < 11 * number_words; ++i) {
+		EXPECT_EQ(pattern_data[i], decoded_data[i]);
+	}
+
+	hamming_code::MatrixView wrong_shape(11, number_words + 1, decoded_data);
+	EXPECT_EQ(hamming_code::kInvalidArgument,
+			hamming_coder_.Decode(encoded, &wrong_shape));
+}
+
+TEST_F(HammingCoderTest, CorrectInPlaceAndCorrectAndDecode) {
+	size_t number_words = 3;
+	hamming_code::Matrix::Value pattern_data[] = {
+			1, 0, 0, 1, 0, 0, 1, 0, 1, 1, 0,
+			0, 1, 1, 0, 1, 0, 0, 0, 1, 0, 1,
+			1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+	hamming_code::Matrix::Value encoded_data[15 * 3];
+	EXPECT_EQ(0, hamming_coder_.Encode(pattern_data, number_words, encoded_data));
+	hamming_code::Matrix::Value error_data[15 * 3];
+	std::copy(encoded_data, encoded_data + 15 * 3, error_data);
+	error_data[0 * 15 + 2] ^= 1;
+	error_data[2 * 15 + 7] ^= 1;
+
+	hamming_code::Matrix::Value decoded_data[11 * 3];
+	EXPECT_EQ(0, hamming_coder_.CorrectAndDecode(error_data, number_words, decoded_data));
+	for (size_t i = 0; i < 11 * number_words; ++i) {
+		EXPECT_EQ(pattern_data[i], decoded_data[i]);
+	}
+
+	EXPECT_EQ(0, hamming_coder_.Correct(error_data, number_words));
+	for (size_t i = 0; i < 15 * number_words; ++i) {
+		EXPECT_EQ(encoded_data[i], error_data[i]);
+	}
+}
+
+TEST_F(HammingCoderTest, TableEngineMatchesMatrixEngine) {
+	size_t number_words = 3;
+	hamming_code::Matrix::Value pattern_data[] = {
+			1, 0, 0, 1, 0, 0, 1, 0, 1, 1, 0,
+			0, 1, 1, 0, 1, 0, 0, 0, 1, 0, 1,
+			1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+	hamming_code::Matrix::Value encoded_data[15 * 3];
+	EXPECT_EQ(0, hamming_coder_.Encode(pattern_data, number_words, encoded_data));
+
+	EXPECT_EQ(0, hamming_coder_.SetEngine(hamming_code::HammingCoder::kTableEngine));
+	EXPECT_EQ(hamming_code::HammingCoder::kTableEngine, hamming_coder_.GetEngine());
+	hamming_code::Matrix::Value table_encoded_data[15 * 3];
+	EXPECT_EQ(0, hamming_coder_.Encode(pattern_data, number_words, table_encoded_data));
+	for (size_t i = 0; i < 15 * number_words; ++i) {
+		EXPECT_EQ(encoded_data[i], table_encoded_data[i]);
+	}
+	table_encoded_data[0 * 15 + 9] ^= 1;
+	table_encoded_data[1 * 15 + 14] ^= 1;
+	EXPECT_EQ(0, hamming_coder_.Correct(table_encoded_data, number_words));
+	for (size_t i = 0; i < 15 * number_words; ++i) {
+		EXPECT_EQ(encoded_data[i], table_encoded_data[i]);
+	}
+}
+
+TEST_F(HammingCoderTest, VerifyFindsDirtyWords) {
+	// More words than Verify checks at once.
+	size_t number_words = 300;
+	std::vector<hamming_code::Matrix::Value> data(11 * number_words);
+	for (size_t i = 0; i < data.size(); ++i) {
+		data[i] = (i * 5 + i / 3) % 2;
+	}
+	std::vector<hamming_code::Matrix::Value> words(15 * number_words);
+	EXPECT_EQ(0, hamming_coder_.Encode(&data[0], number_words, &words[0]));
+	hamming_code::MatrixView data_view(11, number_words, &data[0]);
+	std::vector<hamming_code::Matrix::Value> encoded_values(15 * number_words);
+	hamming_code::MatrixView encoded_view(15, number_words, &encoded_values[0]);
+	EXPECT_EQ(0, hamming_coder_.Encode(data_view, &encoded_view));
+
+	size_t dirty_word_indices[] = { 3, 257, 299 };
+	std::vector<size_t> expected_dirty_words(dirty_word_indices,
+			dirty_word_indices + 3);
+	for (size_t i = 0; i < 3; ++i) {
+		size_t word_i = dirty_word_indices[i];
+		words[word_i * 15 + i + 4] ^= 1;
+		encoded_view.SetElement(i + 4, word_i,
+				encoded_view.GetElement(i + 4, word_i) ^ 1);
+	}
+	hamming_code::HammingCoder::Engine engines[] = {
+			hamming_code::HammingCoder::kMatrixEngine,
+			hamming_code::HammingCoder::kTableEngine };
+	for (size_t engine_i = 0; engine_i < 2; ++engine_i) {
+		EXPECT_EQ(0, hamming_coder_.SetEngine(engines[engine_i]));
+		std::vector<size_t> dirty_words(1, 0);
+		EXPECT_EQ(0, hamming_coder_.Verify(encoded_view, &dirty_words));
+		EXPECT_TRUE(expected_dirty_words == dirty_words);
+		EXPECT_EQ(0, hamming_coder_.Verify(&words[0], number_words, &dirty_words));
+		EXPECT_TRUE(expected_dirty_words == dirty_words);
+	}
+	for (size_t i = 0; i < 3; ++i) {
+		EXPECT_EQ(0, hamming_coder_.Correct(&words[dirty_word_indices[i] * 15], 1));
+	}
+	std::vector<size_t> dirty_words;
+	EXPECT_EQ(0, hamming_coder_.Verify(&words[0], number_words, &dirty_words));
+	EXPECT_TRUE(dirty_words.empty());
+	hamming_code::MatrixView wrong_shape(11, number_words, &data[0]);
+	EXPECT_EQ(hamming_code::kInvalidArgument,
+			hamming_coder_.Verify(wrong_shape, &dirty_words));
+}
+
+TEST_F(HammingCoderTest, SaveAndLoad) {
+	std::string path = testing::TempDir() + "hamming_coder_test_state";
+	EXPECT_EQ(0, hamming_coder_.Save(path.c_str()));
+	hamming_code::HammingCoder loaded_coder;
+	EXPECT_EQ(0, hamming_code::HammingCoder::Load(path.c_str(), &loaded_coder));
+	EXPECT_EQ(15U, loaded_coder.GetWordLength());
+	EXPECT_EQ(11U, loaded_coder.GetDataLength());
+
+	hamming_code::Matrix::Value pattern_data[] = { 1, 0, 0, 1, 0, 0, 1, 0, 1, 1, 0 };
+	hamming_code::Matrix::Value encoded_data[15];
+	EXPECT_EQ(0, hamming_coder_.Encode(pattern_data, 1, encoded_data));
+	hamming_code::HammingCoder copied_coder(loaded_coder);
+	EXPECT_EQ(0, copied_coder.SetEngine(hamming_code::HammingCoder::kTableEngine));
+	hamming_code::HammingCoder *coders[] = { &loaded_coder, &copied_coder };
+	for (size_t coder_i = 0; coder_i < 2; ++coder_i) {
+		hamming_code::Matrix::Value loaded_encoded_data[15];
+		EXPECT_EQ(0, coders[coder_i]->Encode(pattern_data, 1, loaded_encoded_data));
+		loaded_encoded_data[6] ^= 1;
+		hamming_code::Matrix::Value decoded_data[11];
+		EXPECT_EQ(0, coders[coder_i]->CorrectAndDecode(loaded_encoded_data, 1, decoded_data));
+		for (size_t i = 0; i < 11; ++i) {
+			EXPECT_EQ(pattern_data[i], decoded_data[i]);
+		}
+	}
+
+	WriteImageField(path, IMAGE_FIELD(word_length), 16);
+	EXPECT_EQ(hamming_code::kInvalidArgument,
+			hamming_code::HammingCoder::Load(path.c_str(), &loaded_coder));
+	EXPECT_EQ(15U, loaded_coder.GetWordLength());
+
+	// A receiver matrix of n rows read from the generator matrix would make
+	// Decode write n symbols per word.
+	EXPECT_EQ(0, hamming_coder_.Save(path.c_str()));
+	WriteImageField(path, IMAGE_FIELD(receiver_length), 15);
+	WriteImageField(path, IMAGE_FIELD(receiver_offset),
+			ReadImageField(path, IMAGE_FIELD(generator_offset)));
+	WriteImageField(path, IMAGE_FIELD(number_data_positions), 0);
+	EXPECT_EQ(hamming_code::kInvalidArgument,
+			hamming_code::HammingCoder::Load(path.c_str(), &loaded_coder));
+
+	// The data positions and the systematic flag must agree with the
+	// receiver matrix.
+	EXPECT_EQ(0, hamming_coder_.Save(path.c_str()));
+	uint64_t systematic = ReadImageField(path, IMAGE_FIELD(systematic));
+	WriteImageField(path, IMAGE_FIELD(systematic), !systematic);
+	EXPECT_EQ(hamming_code::kInvalidArgument,
+			hamming_code::HammingCoder::Load(path.c_str(), &loaded_coder));
+	EXPECT_EQ(0, hamming_coder_.Save(path.c_str()));
+	uint64_t data_positions_offset = ReadImageField(path,
+			IMAGE_FIELD(data_positions_offset));
+	uint64_t positions = ReadImageField(path, data_positions_offset);
+	WriteImageField(path, data_positions_offset, (positions << 32) | (positions >> 32));
+	EXPECT_EQ(hamming_code::kInvalidArgument,
+			hamming_code::HammingCoder::Load(path.c_str(), &loaded_coder));
+	EXPECT_EQ(0, hamming_coder_.Save(path.c_str()));
+	WriteImageField(path, IMAGE_FIELD(number_data_positions), 0);
+	WriteImageField(path, IMAGE_FIELD(systematic), 1);
+	EXPECT_EQ(hamming_code::kInvalidArgument,
+			hamming_code::HammingCoder::Load(path.c_str(), &loaded_coder));
+	// GF(4) is not the integers modulo 4, where 2 has no inverse.
+	EXPECT_EQ(0, hamming_coder_.Save(path.c_str()));
+	WriteImageField(path, IMAGE_FIELD(alphabet_size), 4);
+	EXPECT_EQ(hamming_code::kInvalidArgument,
+			hamming_code::HammingCoder::Load(path.c_str(), &loaded_coder));
+	EXPECT_EQ(0, hamming_coder_.Save(path.c_str()));
+	EXPECT_EQ(0, hamming_code::HammingCoder::Load(path.c_str(), &loaded_coder));
+	remove(path.c_str());
+	EXPECT_EQ(hamming_code::kIoError,
+			hamming_code::HammingCoder::Load(path.c_str(), &loaded_coder));
+}
+
+TEST_F(HammingCoderTest, SharedCoderAcrossThreads) {
+	EXPECT_EQ(0, hamming_coder_.SetEngine(hamming_code::HammingCoder::kTableEngine));
+	const size_t number_threads = 4;
+	pthread_t threads[number_threads];
+	SharedCoderThread arguments[number_threads];
+	for (size_t i = 0; i < number_threads; ++i) {
+		arguments[i].coder = &hamming_coder_;
+		arguments[i].seed = i;
+		arguments[i].number_failures = 0;
+		pthread_create(&threads[i], NULL, RunSharedCoderThread, &arguments[i]);
+	}
+	for (size_t i = 0; i < number_threads; ++i) {
+		pthread_join(threads[i], NULL);
+		EXPECT_EQ(0, arguments[i].number_failures);
+	}
+}
@@ -0,0 +1,181 @@
+/*
+ * HammingStreamCoderTest.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <vector>
+#include "../src/BinaryHammingCoder.h"
+#include "../src/HammingCodeFactory.h"
+#include "../src/HammingStreamCoder.h"
+#include "../src/HammingCoder.h"
+#include "../src/Matrix.h"
+#include "../src/Status.h"
+
+using namespace std;
+
+class HammingStreamCoderTest: public ::testing::Test {
+protected:
+	virtual void SetUp() {
+		hamming_code::Matrix::Value generator_matrix_data[] = { 1, 1, 0, 1, 1, 0, 1,
+				0, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 0, 1, 1, 1, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 1, 1, 1, 1, 0, 1, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0,
+				0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 };
+		generator_matrix_ = hamming_code::Matrix(15, 11, generator_matrix_data);
+
+		hamming_code::Matrix::Value checker_matrix_data[] = { 1, 0, 1, 0, 1, 0, 1,
+				0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0,
+				1, 1, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0,
+				0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1 };
+		checker_matrix_ = hamming_code::Matrix(4, 15, checker_matrix_data);
+
+		hamming_code::Matrix::Value reciver_matrix_data[] = { 0, 0, 1, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+				0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 };
+		receiver_matrix_ = hamming_code::Matrix(11, 15, reciver_matrix_data);
+
+		binary_hamming_coder_ = hamming_code::BinaryHammingCoder(
+				generator_matrix_, checker_matrix_, receiver_matrix_);
+	}
+
+	virtual void TearDown() {
+	}
+	hamming_code::Matrix generator_matrix_;
+	hamming_code::Matrix checker_matrix_;
+	hamming_code::Matrix receiver_matrix_;
+	hamming_code::BinaryHammingCoder binary_hamming_coder_;
+};
+
+TEST_F(HammingStreamCoderTest, EncodeAndDecodeOneErrorWords) {
+	size_t length = 1000;
+	vector<uint8_t> data(length);
+	for (size_t i = 0; i < length; ++i) {
+		data[i] = (i * 131 + 7) & 0xff;
+	}
+
+	hamming_code::HammingStreamCoder encoder(&binary_hamming_coder_,
+			hamming_code::HammingStreamCoder::kEncode);
+	vector<uint8_t> encoded_data(encoder.GetMaxOutputLength(length));
+	size_t encoded_length = 0;
+	for (size_t offset = 0; offset < length;) {
+		size_t chunk_length = std::min(length - offset, offset % 7 + 1);
+		size_t output_length = encoded_data.size() - encoded_length;
+		EXPECT_EQ(0, encoder.Process(&data[offset], chunk_length,
+				&encoded_data[encoded_length], &output_length));
+		encoded_length += output_length;
+		offset += chunk_length;
+	}
+	size_t output_length = encoded_data.size() - encoded_length;
+	EXPECT_EQ(0, encoder.Finish(&encoded_data[encoded_length], &output_length));
+	encoded_length += output_length;
+	size_t number_words = (length * 8 + 10) / 11;
+	EXPECT_EQ((number_words * 15 + 7) / 8, encoded_length);
+
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		size_t bit = word_i * 15 + word_i % 15;
+		encoded_data[bit / 8] ^= 1 << (bit % 8);
+	}
+
+	hamming_code::HammingStreamCoder decoder(&binary_hamming_coder_,
+			hamming_code::HammingStreamCoder::kDecode);
+	vector<uint8_t> decoded_data(decoder.GetMaxOutputLength(encoded_length));
+	size_t decoded_length = decoded_data.size();
+	EXPECT_EQ(0, decoder.Process(&encoded_data[0], encoded_length, &decoded_data[0],
+			&decoded_length));
+	output_length = decoded_data.size() - decoded_length;
+	EXPECT_EQ(0, decoder.Finish(&decoded_data[decoded_length], &output_length));
+	decoded_length += output_length;
+	EXPECT_LE(length, decoded_length);
+	for (size_t i = 0; i < length; ++i) {
+		EXPECT_EQ(data[i], decoded_data[i]);
+	}
+}
+
+TEST_F(HammingStreamCoderTest, ProcessWithSmallOutput) {
+	hamming_code::HammingStreamCoder encoder(&binary_hamming_coder_,
+			hamming_code::HammingStreamCoder::kEncode);
+	uint8_t data[4] = { 1, 2, 3, 4 };
+	uint8_t encoded_data[4];
+	size_t output_length = sizeof(encoded_data);
+	EXPECT_EQ(1, encoder.Process(data, sizeof(data), encoded_data, &output_length));
+}
+
+TEST_F(HammingStreamCoderTest, DecodeUncorrectableWord) {
+	hamming_code::Matrix generator_matrix;
+	hamming_code::Matrix checker_matrix;
+	hamming_code::Matrix receiver_matrix;
+	EXPECT_EQ(0, hamming_code::HammingCodeFactory::CreateExtendedMatrices(2, 4,
+			&generator_matrix, &checker_matrix, &receiver_matrix));
+	hamming_code::BinaryHammingCoder coder(generator_matrix, checker_matrix,
+			receiver_matrix);
+	uint8_t data[11] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+	hamming_code::HammingStreamCoder encoder(&coder,
+			hamming_code::HammingStreamCoder::kEncode);
+	vector<uint8_t> encoded_data(encoder.GetMaxOutputLength(sizeof(data)));
+	size_t encoded_length = encoded_data.size();
+	EXPECT_EQ(0, encoder.Process(data, sizeof(data), &encoded_data[0],
+			&encoded_length));
+	size_t output_length = encoded_data.size() - encoded_length;
+	EXPECT_EQ(0, encoder.Finish(&encoded_data[encoded_length], &output_length));
+	encoded_length += output_length;
+
+	hamming_code::HammingStreamCoder decoder(&coder,
+			hamming_code::HammingStreamCoder::kDecode);
+	vector<uint8_t> decoded_data(decoder.GetMaxOutputLength(encoded_length));
+	size_t decoded_length = decoded_data.size();
+	EXPECT_EQ(hamming_code::kSuccess, decoder.Process(&encoded_data[0],
+			encoded_length, &decoded_data[0], &decoded_length));
+	EXPECT_EQ(hamming_code::kSuccess, decoder.Reset());
+
+	// A double error in the second code word.
+	encoded_data[2] ^= 0x03;
+	decoded_length = decoded_data.size();
+	EXPECT_EQ(hamming_code::kUncorrectableError, decoder.Process(
+			&encoded_data[0], encoded_length, &decoded_data[0], &decoded_length));
+	output_length = decoded_data.size() - decoded_length;
+	EXPECT_EQ(hamming_code::kSuccess, decoder.Finish(&decoded_data[decoded_length],
+			&output_length));
+}
@@ -0,0 +1,104 @@
+/*
+ * InterleavedHammingCoderTest.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <vector>
+#include "../src/HammingCodeFactory.h"
+#include "../src/HammingCoder.h"
+#include "../src/InterleavedHammingCoder.h"
+#include "../src/Matrix.h"
+#include "../src/MatrixArena.h"
+
+using namespace std;
+
+class InterleavedHammingCoderTest: public ::testing::Test {
+protected:
+	virtual void SetUp() {
+		hamming_code::HammingCodeFactory::CreateCoder(2, 4, &hamming_coder_);
+	}
+
+	virtual void TearDown() {
+	}
+	hamming_code::HammingCoder hamming_coder_;
+};
+
+TEST_F(InterleavedHammingCoderTest, CorrectBurst) {
+	size_t depth = 8;
+	size_t number_blocks = 2;
+	size_t number_words = depth * number_blocks;
+	vector<hamming_code::Matrix::Value> data(number_words * 11);
+	for (size_t i = 0; i < data.size(); ++i) {
+		data[i] = (i * 5 + i / 7) % 2;
+	}
+	hamming_code::InterleavedHammingCoder coder(&hamming_coder_, depth);
+	EXPECT_EQ(depth, coder.GetDepth());
+	vector<hamming_code::Matrix::Value> data_blocks(data.size());
+	EXPECT_EQ(0, hamming_code::InterleavedHammingCoder::Interleave(&data[0],
+			11, depth, number_blocks, &data_blocks[0]));
+	vector<hamming_code::Matrix::Value> encoded_blocks(number_words * 15);
+	EXPECT_EQ(0, coder.Encode(&data_blocks[0], number_blocks, &encoded_blocks[0]));
+
+	vector<hamming_code::Matrix::Value> words(encoded_blocks.size());
+	EXPECT_EQ(0, hamming_code::InterleavedHammingCoder::Deinterleave(
+			&encoded_blocks[0], 15, depth, number_blocks, &words[0]));
+	vector<hamming_code::Matrix::Value> expected_words(words.size());
+	EXPECT_EQ(0, hamming_coder_.Encode(&data[0], number_words, &expected_words[0]));
+	EXPECT_TRUE(expected_words == words);
+
+	vector<hamming_code::Matrix::Value> error_blocks(encoded_blocks);
+	// Words 5-7 of block 0 and words 0-4 of block 1.
+	for (size_t i = 15 * depth - 3; i < 15 * depth - 3 + depth; ++i) {
+		error_blocks[i] ^= 1;
+	}
+	// The other words of each block.
+	for (size_t i = 16; i < 21; ++i) {
+		error_blocks[i] ^= 1;
+	}
+	for (size_t i = 15 * depth + 45; i < 15 * depth + 48; ++i) {
+		error_blocks[i] ^= 1;
+	}
+	vector<hamming_code::Matrix::Value> decoded_blocks(data_blocks.size());
+	EXPECT_EQ(0, coder.CorrectAndDecode(&error_blocks[0], number_blocks,
+			&decoded_blocks[0]));
+	EXPECT_TRUE(data_blocks == decoded_blocks);
+	vector<hamming_code::Matrix::Value> arena_blocks(error_blocks);
+	EXPECT_EQ(0, coder.Correct(&error_blocks[0], number_blocks));
+	EXPECT_TRUE(encoded_blocks == error_blocks);
+	hamming_code::MatrixArena arena;
+	EXPECT_EQ(0, coder.Correct(&arena_blocks[0], number_blocks, &arena));
+	EXPECT_TRUE(encoded_blocks == arena_blocks);
+	EXPECT_EQ(0, coder.Decode(&error_blocks[0], number_blocks, &decoded_blocks[0]));
+	EXPECT_TRUE(data_blocks == decoded_blocks);
+}
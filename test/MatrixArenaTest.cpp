@@ -0,0 +1,66 @@
+/*
+ * MatrixArenaTest.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include "../src/MatrixArena.h"
+
+using namespace std;
+
+class MatrixArenaTest: public ::testing::Test {
+protected:
+	virtual void SetUp() {
+	}
+
+	virtual void TearDown() {
+	}
+};
+
+TEST_F(MatrixArenaTest, ResetReusesOneBlock) {
+	hamming_code::MatrixArena arena(16);
+	hamming_code::MatrixView view0 = arena.Allocate(2, 4);
+	hamming_code::MatrixView view1 = arena.Allocate(4, 4);
+	EXPECT_EQ(2U, view0.GetNumberRows());
+	EXPECT_EQ(4U, view1.GetNumberColums());
+	EXPECT_NE(view0.GetElements(), view1.GetElements());
+	size_t capacity = arena.GetCapacity();
+	EXPECT_LE(24U, capacity);
+
+	arena.Reset();
+	EXPECT_EQ(capacity, arena.GetCapacity());
+	hamming_code::MatrixView view2 = arena.Allocate(2, 4);
+	hamming_code::MatrixView view3 = arena.Allocate(4, 4);
+	EXPECT_EQ(view2.GetElements() + 8, view3.GetElements());
+	EXPECT_EQ(capacity, arena.GetCapacity());
+}
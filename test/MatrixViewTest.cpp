@@ -0,0 +1,112 @@
+/*
+ * MatrixViewTest.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+#include "../src/Matrix.h"
+#include "../src/MatrixView.h"
+
+using namespace std;
+
+class MatrixViewTest: public ::testing::Test {
+protected:
+	virtual void SetUp() {
+		hamming_code::Matrix::Value values0[] = { 0, 1, 2, 3 };
+		std::copy(values0, values0 + 4, values0_);
+		hamming_code::Matrix::Value values1[] = { 1, 0, 0, 1 };
+		std::copy(values1, values1 + 4, values1_);
+	}
+
+	virtual void TearDown() {
+	}
+	hamming_code::Matrix::Value values0_[4];
+	hamming_code::Matrix::Value values1_[4];
+};
+
+TEST_F(MatrixViewTest, Multiply) {
+	hamming_code::MatrixView view0(2, 2, values0_);
+	hamming_code::MatrixView view1(2, 2, values1_);
+	hamming_code::Matrix::Value ret_values[4];
+	hamming_code::MatrixView ret(2, 2, ret_values);
+	EXPECT_EQ(0, hamming_code::MatrixView::Multiply(view0, view1, &ret));
+	EXPECT_EQ(0, ret.GetElement(0, 0));
+	EXPECT_EQ(1, ret.GetElement(0, 1));
+	EXPECT_EQ(2, ret.GetElement(1, 0));
+	EXPECT_EQ(3, ret.GetElement(1, 1));
+
+	hamming_code::MatrixView wrong_shape(1, 4, ret_values);
+	EXPECT_EQ(1, hamming_code::MatrixView::Multiply(view0, view1, &wrong_shape));
+}
+
+TEST_F(MatrixViewTest, ViewOfMatrix) {
+	hamming_code::Matrix matrix(2, 2, values0_);
+	hamming_code::MatrixView view(matrix);
+	view.SetElement(1, 0, 5);
+	EXPECT_EQ(5, matrix.GetElement(1, 0));
+	hamming_code::MatrixView copy(2, 2, values1_);
+	EXPECT_EQ(0, hamming_code::MatrixView::Copy(view, &copy));
+	EXPECT_EQ(5, values1_[2]);
+	EXPECT_EQ(3, values1_[3]);
+}
+
+TEST_F(MatrixViewTest, BlockedMultiplyMatchesNaive) {
+	size_t number_rows = 13;
+	size_t length = 300;
+	size_t number_columns = 130;
+	std::vector<hamming_code::Matrix::Value> values0(number_rows * length);
+	std::vector<hamming_code::Matrix::Value> values1(length * number_columns);
+	for (size_t i = 0; i < values0.size(); ++i) {
+		values0[i] = (i * 7 + 1) % 5;
+	}
+	for (size_t i = 0; i < values1.size(); ++i) {
+		values1[i] = (i * 3 + 2) % 7;
+	}
+	hamming_code::MatrixView view0(number_rows, length, &values0[0]);
+	hamming_code::MatrixView view1(length, number_columns, &values1[0]);
+	std::vector<hamming_code::Matrix::Value> ret_values(
+			number_rows * number_columns);
+	hamming_code::MatrixView ret(number_rows, number_columns, &ret_values[0]);
+	EXPECT_EQ(0, hamming_code::MatrixView::Multiply(view0, view1, &ret));
+	for (size_t row_i = 0; row_i < number_rows; ++row_i) {
+		for (size_t column_i = 0; column_i < number_columns; ++column_i) {
+			hamming_code::Matrix::Value expected = 0;
+			for (size_t i = 0; i < length; ++i) {
+				expected += view0.GetElement(row_i, i) * view1.GetElement(i, column_i);
+			}
+			EXPECT_EQ(expected, ret.GetElement(row_i, column_i));
+		}
+	}
+}
@@ -0,0 +1,110 @@
+/*
+ * ParallelHammingCoderTest.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include "../src/HammingCoder.h"
+#include "../src/ParallelHammingCoder.h"
+#include "../src/Matrix.h"
+
+using namespace std;
+
+class ParallelHammingCoderTest: public ::testing::Test {
+protected:
+	virtual void SetUp() {
+		hamming_code::Matrix::Value generator_matrix_data[] = { 1, 1, 0, 1, 1, 0, 1,
+				0, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 0, 1, 1, 1, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 1, 1, 1, 1, 0, 1, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0,
+				0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 };
+		hamming_code::Matrix generator_matrix(15, 11, generator_matrix_data);
+
+		hamming_code::Matrix::Value checker_matrix_data[] = { 1, 0, 1, 0, 1, 0, 1,
+				0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0,
+				1, 1, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0,
+				0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1 };
+		hamming_code::Matrix checker_matrix(4, 15, checker_matrix_data);
+
+		hamming_code::Matrix::Value reciver_matrix_data[] = { 0, 0, 1, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+				0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0,
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 };
+		hamming_code::Matrix receiver_matrix(11, 15, reciver_matrix_data);
+
+		hamming_coder_ = hamming_code::HammingCoder(2, generator_matrix,
+				checker_matrix, receiver_matrix);
+	}
+
+	virtual void TearDown() {
+	}
+	hamming_code::HammingCoder hamming_coder_;
+};
+
+TEST_F(ParallelHammingCoderTest, DecodeOneErrorWords) {
+	size_t number_words = 10000;
+	vector<hamming_code::Matrix::Value> data(number_words * 11);
+	for (size_t i = 0; i < data.size(); ++i) {
+		data[i] = (i * 7 / 3) % 2;
+	}
+	hamming_code::ParallelHammingCoder parallel_hamming_coder(&hamming_coder_, 4, 333);
+	EXPECT_EQ(4u, parallel_hamming_coder.GetNumberThreads());
+
+	vector<hamming_code::Matrix::Value> encoded_data(number_words * 15);
+	EXPECT_EQ(0, parallel_hamming_coder.Encode(&data[0], number_words, &encoded_data[0]));
+	vector<hamming_code::Matrix::Value> expected_encoded_data(number_words * 15);
+	EXPECT_EQ(0, hamming_coder_.Encode(&data[0], number_words, &expected_encoded_data[0]));
+	EXPECT_TRUE(expected_encoded_data == encoded_data);
+
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		encoded_data[word_i * 15 + word_i % 15] ^= 1;
+	}
+	vector<hamming_code::Matrix::Value> corrected_data(number_words * 15);
+	EXPECT_EQ(0, parallel_hamming_coder.Correct(&encoded_data[0], number_words, &corrected_data[0]));
+	EXPECT_TRUE(expected_encoded_data == corrected_data);
+
+	vector<hamming_code::Matrix::Value> decoded_data(number_words * 11);
+	EXPECT_EQ(0, parallel_hamming_coder.Decode(&corrected_data[0], number_words, &decoded_data[0]));
+	EXPECT_TRUE(data == decoded_data);
+}
@@ -0,0 +1,99 @@
+/*
+ * SparseMatrixTest.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <vector>
+#include "../src/GaloisField.h"
+#include "../src/Matrix.h"
+#include "../src/MatrixView.h"
+#include "../src/SparseMatrix.h"
+
+using namespace std;
+
+class SparseMatrixTest: public ::testing::Test {
+protected:
+	virtual void SetUp() {
+	}
+
+	virtual void TearDown() {
+	}
+};
+
+TEST_F(SparseMatrixTest, MultiplyMatchesDense) {
+	size_t number_rows = 7;
+	size_t length = 40;
+	// More columns than one chunk.
+	size_t number_columns = 300;
+	hamming_code::GaloisField field(5);
+	std::vector<hamming_code::Matrix::Value> values0(number_rows * length);
+	std::vector<hamming_code::Matrix::Value> values1(length * number_columns);
+	for (size_t i = 0; i < values0.size(); ++i) {
+		values0[i] = i % 3 == 0 ? (i * 7 + 1) % 5 : 0;
+	}
+	for (size_t i = 0; i < values1.size(); ++i) {
+		values1[i] = (i * 3 + 2) % 5;
+	}
+	hamming_code::MatrixView view0(number_rows, length, &values0[0]);
+	hamming_code::MatrixView view1(length, number_columns, &values1[0]);
+	hamming_code::SparseMatrix matrix(view0);
+	EXPECT_EQ(number_rows, matrix.GetNumberRows());
+	EXPECT_EQ(length, matrix.GetNumberColums());
+	size_t number_nonzeros = 0;
+	for (size_t i = 0; i < values0.size(); ++i) {
+		number_nonzeros += values0[i] != 0;
+	}
+	EXPECT_EQ(number_nonzeros, matrix.GetNumberNonzeros());
+
+	std::vector<hamming_code::Matrix::Value> expected_values(
+			number_rows * number_columns);
+	hamming_code::MatrixView expected(number_rows, number_columns,
+			&expected_values[0]);
+	EXPECT_EQ(0, hamming_code::MatrixView::Multiply(view0, view1, &expected,
+			&field));
+	std::vector<hamming_code::Matrix::Value> ret_values(expected_values.size());
+	hamming_code::MatrixView ret(number_rows, number_columns, &ret_values[0]);
+	EXPECT_EQ(0, hamming_code::SparseMatrix::Multiply(matrix, view1, &ret,
+			&field));
+	EXPECT_TRUE(expected_values == ret_values);
+	for (size_t row_i = 0; row_i < number_rows; ++row_i) {
+		EXPECT_EQ(expected.GetElement(row_i, 1),
+				field.Reduce(matrix.MultiplyRow(row_i, &values1[1], number_columns)));
+	}
+
+	hamming_code::MatrixView wrong_shape(number_columns, number_rows,
+			&ret_values[0]);
+	EXPECT_EQ(1, hamming_code::SparseMatrix::Multiply(matrix, view1,
+			&wrong_shape));
+}
@@ -0,0 +1,78 @@
+/*
+ * ThreadPoolTest.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <vector>
+#include "../src/ThreadPool.h"
+
+using namespace std;
+
+namespace {
+class CountTask: public hamming_code::ThreadPool::Task {
+public:
+	CountTask() :
+			counter_(NULL) {
+	}
+	explicit CountTask(size_t *counter) :
+			counter_(counter) {
+	}
+	virtual void Run() {
+		__sync_fetch_and_add(counter_, 1);
+	}
+private:
+	size_t *counter_;
+};
+}
+
+TEST(ThreadPoolTest, RunAllTasks) {
+	hamming_code::ThreadPool thread_pool(4);
+	EXPECT_EQ(4u, thread_pool.GetNumberThreads());
+	size_t counter = 0;
+	size_t number_tasks = 1000;
+	vector<CountTask> tasks(number_tasks, CountTask(&counter));
+	for (size_t round = 1; round <= 3; ++round) {
+		for (size_t i = 0; i < number_tasks; ++i) {
+			EXPECT_EQ(0, thread_pool.Submit(&tasks[i]));
+		}
+		EXPECT_EQ(0, thread_pool.Wait());
+		EXPECT_EQ(round * number_tasks, counter);
+	}
+}
+
+TEST(ThreadPoolTest, DefaultNumberThreads) {
+	hamming_code::ThreadPool thread_pool(0);
+	EXPECT_LT(0u, thread_pool.GetNumberThreads());
+	EXPECT_EQ(0, thread_pool.Wait());
+}
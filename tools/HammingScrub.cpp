@@ -0,0 +1,483 @@
+/*
+ * HammingScrub.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Protects a file with a binary Hamming code stored in a sidecar file.
+ *
+ *   hamming_scrub encode [-r redundancy] file sidecar
+ *   hamming_scrub scrub [-v] file sidecar
+ *
+ * The file is read as a bit stream of data words and only the parity
+ * symbols of every code word go to the sidecar, so the file itself keeps its
+ * layout. scrub recomputes the syndromes and corrects single errors in place,
+ * in the file or in the sidecar, and reports statistics per window.
+ */
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../src/BinaryHammingCoder.h"
+#include "../src/Matrix.h"
+#include "../src/Status.h"
+
+using namespace std;
+using hamming_code::BinaryHammingCoder;
+using hamming_code::Matrix;
+
+namespace {
+
+const char kSidecarMagic[8] = { 'H', 'M', 'S', 'C', 'R', 'U', 'B', '1' };
+const size_t kDefaultRedundancy = 4;
+const size_t kMinRedundancy = 2;
+const size_t kMaxRedundancy = 6;
+// A window is a multiple of 8 words, so it starts on a byte in both files.
+const size_t kWindowLength = 1 << 16;
+
+struct SidecarHeader {
+	char magic[8];
+	uint64_t redundancy;
+	uint64_t data_length;
+};
+
+struct Statistics {
+	Statistics() :
+			number_words(0), number_clean_words(0), number_corrected_data_words(
+					0), number_corrected_parity_words(0), number_uncorrectable_words(
+					0) {
+	}
+
+	void Add(const Statistics &statistics) {
+		number_words += statistics.number_words;
+		number_clean_words += statistics.number_clean_words;
+		number_corrected_data_words += statistics.number_corrected_data_words;
+		number_corrected_parity_words +=
+				statistics.number_corrected_parity_words;
+		number_uncorrectable_words += statistics.number_uncorrectable_words;
+	}
+
+	size_t number_words;
+	size_t number_clean_words;
+	size_t number_corrected_data_words;
+	size_t number_corrected_parity_words;
+	size_t number_uncorrectable_words;
+};
+
+class MappedFile {
+public:
+	MappedFile() :
+			fd_(-1), data_(NULL), length_(0) {
+	}
+
+	~MappedFile() {
+		Close();
+	}
+
+	int Open(const string &path, bool writable, size_t length) {
+		int flags = writable ? O_RDWR : O_RDONLY;
+		if (length > 0) {
+			flags |= O_CREAT | O_TRUNC;
+		}
+		fd_ = open(path.c_str(), flags, 0644);
+		if (fd_ < 0) {
+			return 1;
+		}
+		if (length > 0) {
+			if (ftruncate(fd_, length) != 0) {
+				return 1;
+			}
+			length_ = length;
+		} else {
+			struct stat file_stat;
+			if (fstat(fd_, &file_stat) != 0) {
+				return 1;
+			}
+			length_ = file_stat.st_size;
+		}
+		if (length_ == 0) {
+			return 0;
+		}
+		int protection = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+		void *data = mmap(NULL, length_, protection, MAP_SHARED, fd_, 0);
+		if (data == MAP_FAILED) {
+			return 1;
+		}
+		data_ = static_cast<uint8_t *>(data);
+		madvise(data_, length_, MADV_SEQUENTIAL);
+		return 0;
+	}
+
+	void Close() {
+		if (data_ != NULL) {
+			munmap(data_, length_);
+			data_ = NULL;
+		}
+		if (fd_ >= 0) {
+			close(fd_);
+			fd_ = -1;
+		}
+	}
+
+	uint8_t *GetData() {
+		return data_;
+	}
+
+	size_t GetLength() const {
+		return length_;
+	}
+
+private:
+	MappedFile(const MappedFile &);
+	MappedFile &operator=(const MappedFile &);
+
+	int fd_;
+	uint8_t *data_;
+	size_t length_;
+};
+
+// Positions of the data symbols and of the parity symbols in a code word.
+struct Layout {
+	vector<size_t> data_positions;
+	vector<size_t> parity_positions;
+	vector<size_t> parity_indices;
+	BinaryHammingCoder::Word parity_mask;
+};
+
+// Builds the binary Hamming code whose i-th checker column is i + 1 written
+// in binary, so the parity symbols sit at the powers of two.
+void BuildMatrices(size_t redundancy, Matrix *generator_matrix,
+		Matrix *checker_matrix, Matrix *receiver_matrix) {
+	size_t word_length = (static_cast<size_t>(1) << redundancy) - 1;
+	size_t data_length = word_length - redundancy;
+	*generator_matrix = Matrix(word_length, data_length);
+	*checker_matrix = Matrix(redundancy, word_length);
+	*receiver_matrix = Matrix(data_length, word_length);
+	vector<size_t> data_positions;
+	for (size_t position = 0; position < word_length; ++position) {
+		size_t column = position + 1;
+		for (size_t row_i = 0; row_i < redundancy; ++row_i) {
+			checker_matrix->SetElement(row_i, position, (column >> row_i) & 1);
+		}
+		if ((column & (column - 1)) != 0) {
+			data_positions.push_back(position);
+		}
+	}
+	for (size_t data_i = 0; data_i < data_length; ++data_i) {
+		size_t position = data_positions[data_i];
+		generator_matrix->SetElement(position, data_i, 1);
+		receiver_matrix->SetElement(data_i, position, 1);
+		for (size_t row_i = 0; row_i < redundancy; ++row_i) {
+			if (((position + 1) >> row_i) & 1) {
+				generator_matrix->SetElement((1 << row_i) - 1, data_i, 1);
+			}
+		}
+	}
+}
+
+void BuildLayout(Matrix &receiver_matrix, Layout *layout) {
+	size_t data_length = receiver_matrix.GetNumberRows();
+	size_t word_length = receiver_matrix.GetNumberColums();
+	vector<bool> is_data(word_length, false);
+	layout->data_positions.assign(data_length, 0);
+	for (size_t data_i = 0; data_i < data_length; ++data_i) {
+		for (size_t position = 0; position < word_length; ++position) {
+			if (receiver_matrix.GetElement(data_i, position)) {
+				layout->data_positions[data_i] = position;
+				is_data[position] = true;
+			}
+		}
+	}
+	layout->parity_positions.clear();
+	layout->parity_indices.assign(word_length, 0);
+	layout->parity_mask = 0;
+	for (size_t position = 0; position < word_length; ++position) {
+		if (!is_data[position]) {
+			layout->parity_indices[position] = layout->parity_positions.size();
+			layout->parity_positions.push_back(position);
+			layout->parity_mask |= static_cast<BinaryHammingCoder::Word>(1)
+					<< position;
+		}
+	}
+}
+
+BinaryHammingCoder::Word ReadBits(const uint8_t *data, size_t length,
+		size_t bit_offset, size_t number_bits) {
+	size_t offset = bit_offset / 8;
+	size_t shift = bit_offset % 8;
+	size_t end = std::min(length, offset + (shift + number_bits + 7) / 8);
+	BinaryHammingCoder::Word bits = 0;
+	for (size_t i = offset; i < end; ++i) {
+		bits |= static_cast<BinaryHammingCoder::Word>(data[i]) << (8 * (i - offset));
+	}
+	return (bits >> shift)
+			& (~static_cast<BinaryHammingCoder::Word>(0) >> (64 - number_bits));
+}
+
+void WriteBits(BinaryHammingCoder::Word bits, size_t bit_offset,
+		size_t number_bits, uint8_t *data) {
+	for (size_t i = 0; i < number_bits; ++i, ++bit_offset) {
+		if ((bits >> i) & 1) {
+			data[bit_offset / 8] |= 1 << (bit_offset % 8);
+		}
+	}
+}
+
+void FlipBit(size_t bit_offset, uint8_t *data) {
+	data[bit_offset / 8] ^= 1 << (bit_offset % 8);
+}
+
+size_t GetNumberWords(size_t data_length, size_t redundancy) {
+	size_t word_data_length = (static_cast<size_t>(1) << redundancy) - 1
+			- redundancy;
+	return (data_length * 8 + word_data_length - 1) / word_data_length;
+}
+
+int Encode(const string &path, const string &sidecar_path, size_t redundancy) {
+	MappedFile file;
+	if (file.Open(path, false, 0) != 0) {
+		cerr << "cannot map " << path << endl;
+		return 1;
+	}
+	Matrix generator_matrix, checker_matrix, receiver_matrix;
+	BuildMatrices(redundancy, &generator_matrix, &checker_matrix,
+			&receiver_matrix);
+	BinaryHammingCoder coder(generator_matrix, checker_matrix,
+			receiver_matrix);
+	Layout layout;
+	BuildLayout(receiver_matrix, &layout);
+	size_t data_length = coder.GetDataLength();
+
+	size_t number_words = GetNumberWords(file.GetLength(), redundancy);
+	MappedFile sidecar;
+	size_t sidecar_length = sizeof(SidecarHeader)
+			+ (number_words * redundancy + 7) / 8;
+	if (sidecar.Open(sidecar_path, true, sidecar_length) != 0) {
+		cerr << "cannot map " << sidecar_path << endl;
+		return 1;
+	}
+	SidecarHeader header;
+	memcpy(header.magic, kSidecarMagic, sizeof(header.magic));
+	header.redundancy = redundancy;
+	header.data_length = file.GetLength();
+	memcpy(sidecar.GetData(), &header, sizeof(header));
+	uint8_t *parity = sidecar.GetData() + sizeof(header);
+	memset(parity, 0, sidecar_length - sizeof(header));
+
+	vector<BinaryHammingCoder::Word> data(kWindowLength);
+	vector<BinaryHammingCoder::Word> encoded_data(kWindowLength);
+	for (size_t window_i = 0; window_i < number_words; window_i +=
+			kWindowLength) {
+		size_t window_length = std::min(kWindowLength, number_words - window_i);
+		for (size_t i = 0; i < window_length; ++i) {
+			data[i] = ReadBits(file.GetData(), file.GetLength(),
+					(window_i + i) * data_length, data_length);
+		}
+		coder.Encode(&data[0], window_length, &encoded_data[0]);
+		for (size_t i = 0; i < window_length; ++i) {
+			BinaryHammingCoder::Word parity_bits = 0;
+			for (size_t j = 0; j < redundancy; ++j) {
+				parity_bits |= ((encoded_data[i] >> layout.parity_positions[j])
+						& 1) << j;
+			}
+			WriteBits(parity_bits, (window_i + i) * redundancy, redundancy,
+					parity);
+		}
+	}
+	return 0;
+}
+
+int Scrub(const string &path, const string &sidecar_path, bool verbose) {
+	MappedFile sidecar;
+	if (sidecar.Open(sidecar_path, true, 0) != 0
+			|| sidecar.GetLength() < sizeof(SidecarHeader)) {
+		cerr << "cannot map " << sidecar_path << endl;
+		return 1;
+	}
+	SidecarHeader header;
+	memcpy(&header, sidecar.GetData(), sizeof(header));
+	if (memcmp(header.magic, kSidecarMagic, sizeof(header.magic)) != 0
+			|| header.redundancy < kMinRedundancy
+			|| header.redundancy > kMaxRedundancy) {
+		cerr << sidecar_path << " is not a sidecar file" << endl;
+		return 1;
+	}
+	size_t redundancy = header.redundancy;
+	MappedFile file;
+	if (file.Open(path, true, 0) != 0
+			|| file.GetLength() != header.data_length) {
+		cerr << "cannot map " << path << " or its length has changed" << endl;
+		return 1;
+	}
+	size_t number_words = GetNumberWords(file.GetLength(), redundancy);
+	if (sidecar.GetLength()
+			< sizeof(header) + (number_words * redundancy + 7) / 8) {
+		cerr << sidecar_path << " is truncated" << endl;
+		return 1;
+	}
+
+	Matrix generator_matrix, checker_matrix, receiver_matrix;
+	BuildMatrices(redundancy, &generator_matrix, &checker_matrix,
+			&receiver_matrix);
+	BinaryHammingCoder coder(generator_matrix, checker_matrix,
+			receiver_matrix);
+	Layout layout;
+	BuildLayout(receiver_matrix, &layout);
+	size_t data_length = coder.GetDataLength();
+	size_t number_data_bits = file.GetLength() * 8;
+	vector<size_t> data_indices(coder.GetWordLength(), 0);
+	for (size_t data_i = 0; data_i < data_length; ++data_i) {
+		data_indices[layout.data_positions[data_i]] = data_i;
+	}
+
+	uint8_t *parity = sidecar.GetData() + sizeof(header);
+	size_t parity_length = sidecar.GetLength() - sizeof(header);
+	vector<BinaryHammingCoder::Word> data(kWindowLength);
+	vector<BinaryHammingCoder::Word> encoded_data(kWindowLength);
+	Statistics total;
+	for (size_t window_i = 0; window_i < number_words; window_i +=
+			kWindowLength) {
+		size_t window_length = std::min(kWindowLength, number_words - window_i);
+		for (size_t i = 0; i < window_length; ++i) {
+			data[i] = ReadBits(file.GetData(), file.GetLength(),
+					(window_i + i) * data_length, data_length);
+		}
+		coder.Encode(&data[0], window_length, &encoded_data[0]);
+		Statistics statistics;
+		statistics.number_words = window_length;
+		for (size_t i = 0; i < window_length; ++i) {
+			size_t word_i = window_i + i;
+			BinaryHammingCoder::Word parity_bits = ReadBits(parity,
+					parity_length, word_i * redundancy, redundancy);
+			BinaryHammingCoder::Word word = encoded_data[i]
+					& ~layout.parity_mask;
+			for (size_t j = 0; j < redundancy; ++j) {
+				word |= ((parity_bits >> j) & 1) << layout.parity_positions[j];
+			}
+			BinaryHammingCoder::Word corrected_word = 0;
+			if (coder.Correct(word, &corrected_word) != hamming_code::kSuccess) {
+				++statistics.number_uncorrectable_words;
+				continue;
+			}
+			BinaryHammingCoder::Word error = word ^ corrected_word;
+			if (error == 0) {
+				++statistics.number_clean_words;
+				continue;
+			}
+			size_t position = __builtin_ctzll(error);
+			if (error & layout.parity_mask) {
+				FlipBit(word_i * redundancy + layout.parity_indices[position],
+						parity);
+				++statistics.number_corrected_parity_words;
+				continue;
+			}
+			size_t bit_offset = word_i * data_length + data_indices[position];
+			if (bit_offset >= number_data_bits) {
+				++statistics.number_uncorrectable_words;
+				continue;
+			}
+			FlipBit(bit_offset, file.GetData());
+			++statistics.number_corrected_data_words;
+		}
+		if (verbose || statistics.number_clean_words != window_length) {
+			cout << "window " << window_i / kWindowLength << "\twords "
+					<< statistics.number_words << "\tclean "
+					<< statistics.number_clean_words << "\tdata "
+					<< statistics.number_corrected_data_words << "\tparity "
+					<< statistics.number_corrected_parity_words
+					<< "\tuncorrectable "
+					<< statistics.number_uncorrectable_words << endl;
+		}
+		total.Add(statistics);
+	}
+	cout << "total\twords " << total.number_words << "\tclean "
+			<< total.number_clean_words << "\tdata "
+			<< total.number_corrected_data_words << "\tparity "
+			<< total.number_corrected_parity_words << "\tuncorrectable "
+			<< total.number_uncorrectable_words << endl;
+	return total.number_uncorrectable_words == 0 ? 0 : 2;
+}
+
+void PrintUsage() {
+	cerr << "usage: hamming_scrub encode [-r redundancy] file sidecar" << endl;
+	cerr << "       hamming_scrub scrub [-v] file sidecar" << endl;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+	if (argc < 2) {
+		PrintUsage();
+		return 1;
+	}
+	string command = argv[1];
+	size_t redundancy = kDefaultRedundancy;
+	bool verbose = false;
+	optind = 2;
+	int option;
+	while ((option = getopt(argc, argv, "r:v")) != -1) {
+		switch (option) {
+		case 'r':
+			redundancy = atoi(optarg);
+			break;
+		case 'v':
+			verbose = true;
+			break;
+		default:
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (argc - optind != 2 || redundancy < kMinRedundancy
+			|| redundancy > kMaxRedundancy) {
+		PrintUsage();
+		return 1;
+	}
+	string path = argv[optind];
+	string sidecar_path = argv[optind + 1];
+	if (command == "encode") {
+		return Encode(path, sidecar_path, redundancy);
+	} else if (command == "scrub") {
+		return Scrub(path, sidecar_path, verbose);
+	}
+	PrintUsage();
+	return 1;
+}
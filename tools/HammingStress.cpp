@@ -0,0 +1,821 @@
+/*
+ * HammingStress.cpp
+ *
+ *   Copyright (c) 2013, Shuji Suzuki
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ *
+ *   1. Redistributions of source code must retain the above Copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above Copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *   3. Neither the name of the authors nor the names of its contributors
+ *      may be used to endorse or promote products derived from this
+ *      software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ *   ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Randomized round trip stress test and throughput report for the coders.
+ *
+ *   hamming_stress [-n words] [-e error_percent] [-d double_percent]
+ *                  [-s seed]
+ *
+ * For every code and every coder that supports it, random messages are
+ * encoded, random single and double errors are injected into error_percent
+ * of the words, double_percent of them double, and the words are corrected
+ * and decoded. HammingCoder also verifies them and corrects them with the
+ * double error positions marked as erasures. Encoding and decoding are
+ * checked against products of the code matrices computed with plain
+ * modular arithmetic, and every call must return the expected status.
+ * Prints the throughput of every step in data MB/s and exits with 2 if any
+ * word is wrong.
+ */
+
+#include <getopt.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "../src/BinaryHammingCoder.h"
+#include "../src/BitSlicedHammingCoder.h"
+#include "../src/FixedHammingCoder.h"
+#include "../src/HammingCodeFactory.h"
+#include "../src/HammingCoder.h"
+#include "../src/InterleavedHammingCoder.h"
+#include "../src/Matrix.h"
+#include "../src/MatrixArena.h"
+#include "../src/ParallelHammingCoder.h"
+#include "../src/Status.h"
+
+using namespace std;
+using hamming_code::BinaryHammingCoder;
+using hamming_code::BitSlicedHammingCoder;
+using hamming_code::HammingCodeFactory;
+using hamming_code::HammingCoder;
+using hamming_code::InterleavedHammingCoder;
+using hamming_code::Matrix;
+using hamming_code::MatrixArena;
+using hamming_code::ParallelHammingCoder;
+using hamming_code::kSuccess;
+using hamming_code::kUncorrectableError;
+
+namespace {
+
+const size_t kDefaultNumberWords = 1 << 20;
+const size_t kDefaultErrorPercent = 10;
+const size_t kDefaultDoublePercent = 20;
+const size_t kBatchLength = 1 << 16;
+const size_t kInterleavingDepth = 64;
+
+enum Step {
+	kEncode, kVerify, kCorrect, kCorrectErasures, kDecode, kNumberSteps
+};
+
+const char *kStepNames[] = { "encode", "verify", "correct", "erasures",
+		"decode" };
+
+enum ErrorKind {
+	kClean, kSingleError, kDoubleError
+};
+
+typedef uint64_t PackedWord;
+
+struct Code {
+	uint8_t alphabet_size;
+	size_t redundancy;
+	bool extended;
+};
+
+const Code kCodes[] = { { 2, 3, false }, { 2, 4, false }, { 2, 6, false }, {
+		2, 4, true }, { 2, 6, true }, { 3, 3, false }, { 5, 3, false }, { 7,
+		2, false } };
+
+struct Options {
+	size_t number_words;
+	size_t error_percent;
+	size_t double_percent;
+};
+
+struct Result {
+	Result() :
+			number_words(0), number_wrong_words(0), number_miscorrected_words(
+					0) {
+		std::fill(seconds, seconds + kNumberSteps, 0.0);
+		std::fill(has_steps, has_steps + kNumberSteps, false);
+	}
+
+	size_t number_words;
+	// Wrong words and calls that returned a wrong status.
+	size_t number_wrong_words;
+	// Double errors of codes that cannot detect them.
+	size_t number_miscorrected_words;
+	double seconds[kNumberSteps];
+	// Steps the coder supports.
+	bool has_steps[kNumberSteps];
+};
+
+// Random data words, their code words, and the code words with the injected
+// errors, laid out contiguously one symbol per value.
+struct Batch {
+	size_t number_words;
+	size_t word_length;
+	size_t data_length;
+	vector<Matrix::Value> data;
+	vector<Matrix::Value> encoded_data;
+	vector<Matrix::Value> received_data;
+	// Marks the symbols of double errors.
+	vector<uint8_t> erasures;
+	vector<ErrorKind> kinds;
+	vector<size_t> dirty_words;
+};
+
+// xorshift64*, so runs are reproducible from the seed on every platform.
+class Random {
+public:
+	explicit Random(uint64_t seed) :
+			state_(seed != 0 ? seed : 1) {
+	}
+
+	uint64_t Next() {
+		state_ ^= state_ >> 12;
+		state_ ^= state_ << 25;
+		state_ ^= state_ >> 27;
+		return state_ * 2685821657736338717ULL;
+	}
+
+	size_t Next(size_t n) {
+		return Next() % n;
+	}
+
+private:
+	uint64_t state_;
+};
+
+double GetTime() {
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+// ret_words = matrix * words mod q, one word per row of words.
+void MultiplyReference(const Matrix &matrix, uint8_t alphabet_size,
+		const Matrix::Value *words, size_t number_words,
+		Matrix::Value *ret_words) {
+	int q = alphabet_size;
+	size_t number_rows = matrix.GetNumberRows();
+	size_t number_columns = matrix.GetNumberColums();
+	vector<int> elements(number_rows * number_columns);
+	for (size_t i = 0; i < elements.size(); ++i) {
+		elements[i] = (matrix.GetElement(i / number_columns,
+				i % number_columns) % q + q) % q;
+	}
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		const Matrix::Value *word = words + word_i * number_columns;
+		for (size_t row_i = 0; row_i < number_rows; ++row_i) {
+			const int *row = &elements[row_i * number_columns];
+			int sum = 0;
+			for (size_t i = 0; i < number_columns; ++i) {
+				sum += row[i] * word[i];
+			}
+			ret_words[word_i * number_rows + row_i] = sum % q;
+		}
+	}
+}
+
+void MakeBatch(const Code &code, const Matrix &generator_matrix,
+		size_t number_words, const Options &options, Random *random,
+		Batch *batch) {
+	uint8_t q = code.alphabet_size;
+	size_t word_length = generator_matrix.GetNumberRows();
+	size_t data_length = generator_matrix.GetNumberColums();
+	batch->number_words = number_words;
+	batch->word_length = word_length;
+	batch->data_length = data_length;
+	batch->data.resize(number_words * data_length);
+	for (size_t i = 0; i < batch->data.size(); ++i) {
+		batch->data[i] = random->Next(q);
+	}
+	batch->encoded_data.resize(number_words * word_length);
+	MultiplyReference(generator_matrix, q, &batch->data[0], number_words,
+			&batch->encoded_data[0]);
+
+	batch->received_data = batch->encoded_data;
+	batch->erasures.assign(batch->received_data.size(), 0);
+	batch->kinds.assign(number_words, kClean);
+	batch->dirty_words.clear();
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		if (random->Next(100) >= options.error_percent) {
+			continue;
+		}
+		ErrorKind kind =
+				random->Next(100) < options.double_percent ?
+						kDoubleError : kSingleError;
+		batch->kinds[word_i] = kind;
+		size_t positions[2] = { random->Next(word_length), 0 };
+		size_t number_errors = 1;
+		if (kind == kDoubleError) {
+			positions[1] = (positions[0] + 1 + random->Next(word_length - 1))
+					% word_length;
+			number_errors = 2;
+		}
+		for (size_t i = 0; i < number_errors; ++i) {
+			size_t offset = word_i * word_length + positions[i];
+			Matrix::Value *symbol = &batch->received_data[offset];
+			*symbol = (*symbol + 1 + random->Next(q - 1)) % q;
+			if (kind == kDoubleError) {
+				batch->erasures[offset] = 1;
+			}
+		}
+		batch->dirty_words.push_back(word_i);
+	}
+}
+
+// Packs binary words, symbol i into bit i (see BinaryHammingCoder).
+void PackWords(const Matrix::Value *symbols, size_t number_words,
+		size_t word_length, vector<PackedWord> *words) {
+	words->assign(number_words, 0);
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		const Matrix::Value *word = symbols + word_i * word_length;
+		PackedWord packed_word = 0;
+		for (size_t i = 0; i < word_length; ++i) {
+			packed_word |= static_cast<PackedWord>(word[i] & 1) << i;
+		}
+		(*words)[word_i] = packed_word;
+	}
+}
+
+void UnpackWords(const vector<PackedWord> &words, size_t word_length,
+		vector<Matrix::Value> *symbols) {
+	symbols->resize(words.size() * word_length);
+	for (size_t word_i = 0; word_i < words.size(); ++word_i) {
+		for (size_t i = 0; i < word_length; ++i) {
+			(*symbols)[word_i * word_length + i] = (words[word_i] >> i) & 1;
+		}
+	}
+}
+
+void AddTime(Step step, double start_time, Result *result) {
+	result->seconds[step] += GetTime() - start_time;
+	result->has_steps[step] = true;
+}
+
+// A call that returns a wrong status counts as one wrong word.
+void CheckStatus(int status, int expected_status, Result *result) {
+	result->number_wrong_words += status != expected_status;
+}
+
+size_t CountWrongWords(const Matrix::Value *words,
+		const Matrix::Value *expected_words, size_t number_words,
+		size_t word_length) {
+	size_t number_wrong_words = 0;
+	size_t length = number_words * word_length;
+	for (size_t i = 0; i < length; i += word_length) {
+		if (!std::equal(words + i, words + i + word_length,
+				expected_words + i)) {
+			++number_wrong_words;
+		}
+	}
+	return number_wrong_words;
+}
+
+// The first number_words words of the batch must be coded correctly.
+void CheckCodeWords(const Batch &batch, const Matrix::Value *encoded_data,
+		size_t number_words, int status, Result *result) {
+	CheckStatus(status, kSuccess, result);
+	result->number_wrong_words += CountWrongWords(encoded_data,
+			&batch.encoded_data[0], number_words, batch.word_length);
+}
+
+// Extended codes detect double errors, return kUncorrectableError and leave
+// those words as received; other codes miscorrect them.
+void CheckCorrected(const Code &code, const Batch &batch,
+		const Matrix::Value *corrected_data, size_t number_words, int status,
+		Result *result) {
+	size_t word_length = batch.word_length;
+	bool has_double_error = false;
+	for (size_t word_i = 0; word_i < number_words; ++word_i) {
+		size_t offset = word_i * word_length;
+		const Matrix::Value *word = corrected_data + offset;
+		bool is_codeword = std::equal(word, word + word_length,
+				&batch.encoded_data[offset]);
+		if (batch.kinds[word_i] != kDoubleError) {
+			result->number_wrong_words += !is_codeword;
+			continue;
+		}
+		has_double_error = true;
+		if (code.extended) {
+			result->number_wrong_words += !std::equal(word, word + word_length,
+					&batch.received_data[offset]);
+		} else {
+			result->number_miscorrected_words += !is_codeword;
+		}
+	}
+	CheckStatus(status,
+			code.extended && has_double_error ? kUncorrectableError : kSuccess,
+			result);
+}
+
+void CheckDecoded(const Batch &batch, const Matrix::Value *data,
+		size_t number_words, int status, Result *result) {
+	CheckStatus(status, kSuccess, result);
+	result->number_wrong_words += CountWrongWords(data, &batch.data[0],
+			number_words, batch.data_length);
+}
+
+// Codes one batch with one coder, checks the results and adds them to the
+// result. Data and code words are converted to the layout of the coder
+// outside of the timed calls.
+class Runner {
+public:
+	virtual ~Runner() {
+	}
+
+	virtual void Run(const Code &code, const Batch &batch, Result *result) = 0;
+};
+
+class HammingCoderRunner: public Runner {
+public:
+	HammingCoderRunner(const HammingCoder *coder,
+			const Matrix *receiver_matrix) :
+			coder_(coder), receiver_matrix_(receiver_matrix) {
+	}
+
+	virtual void Run(const Code &code, const Batch &batch, Result *result) {
+		size_t number_words = batch.number_words;
+		vector<Matrix::Value> encoded_data(batch.encoded_data.size());
+		double start_time = GetTime();
+		int status = coder_->Encode(&batch.data[0], number_words,
+				&encoded_data[0]);
+		AddTime(kEncode, start_time, result);
+		CheckCodeWords(batch, &encoded_data[0], number_words, status, result);
+
+		vector<size_t> dirty_words;
+		start_time = GetTime();
+		status = coder_->Verify(&batch.received_data[0], number_words,
+				&dirty_words);
+		AddTime(kVerify, start_time, result);
+		CheckStatus(status, kSuccess, result);
+		result->number_wrong_words += dirty_words != batch.dirty_words;
+
+		vector<Matrix::Value> corrected_data(batch.received_data);
+		start_time = GetTime();
+		status = coder_->Correct(&corrected_data[0], number_words);
+		AddTime(kCorrect, start_time, result);
+		CheckCorrected(code, batch, &corrected_data[0], number_words, status,
+				result);
+
+		corrected_data = batch.received_data;
+		start_time = GetTime();
+		status = coder_->CorrectErasures(&corrected_data[0], number_words,
+				&batch.erasures[0]);
+		AddTime(kCorrectErasures, start_time, result);
+		CheckCodeWords(batch, &corrected_data[0], number_words, status,
+				result);
+
+		vector<Matrix::Value> data(batch.data.size());
+		start_time = GetTime();
+		status = coder_->Decode(&batch.encoded_data[0], number_words,
+				&data[0]);
+		AddTime(kDecode, start_time, result);
+		CheckDecoded(batch, &data[0], number_words, status, result);
+		MultiplyReference(*receiver_matrix_, code.alphabet_size,
+				&batch.encoded_data[0], number_words, &data[0]);
+		CheckDecoded(batch, &data[0], number_words, kSuccess, result);
+		result->number_words += number_words;
+	}
+
+private:
+	const HammingCoder *coder_;
+	const Matrix *receiver_matrix_;
+};
+
+class ParallelRunner: public Runner {
+public:
+	explicit ParallelRunner(ParallelHammingCoder *coder) :
+			coder_(coder) {
+	}
+
+	virtual void Run(const Code &code, const Batch &batch, Result *result) {
+		size_t number_words = batch.number_words;
+		vector<Matrix::Value> encoded_data(batch.encoded_data.size());
+		double start_time = GetTime();
+		int status = coder_->Encode(&batch.data[0], number_words,
+				&encoded_data[0]);
+		AddTime(kEncode, start_time, result);
+		CheckCodeWords(batch, &encoded_data[0], number_words, status, result);
+
+		start_time = GetTime();
+		status = coder_->Correct(&batch.received_data[0], number_words,
+				&encoded_data[0]);
+		AddTime(kCorrect, start_time, result);
+		CheckCorrected(code, batch, &encoded_data[0], number_words, status,
+				result);
+
+		vector<Matrix::Value> data(batch.data.size());
+		start_time = GetTime();
+		status = coder_->Decode(&batch.encoded_data[0], number_words,
+				&data[0]);
+		AddTime(kDecode, start_time, result);
+		CheckDecoded(batch, &data[0], number_words, status, result);
+		result->number_words += number_words;
+	}
+
+private:
+	ParallelHammingCoder *coder_;
+};
+
+// Codes the whole blocks of a batch.
+class InterleavedRunner: public Runner {
+public:
+	explicit InterleavedRunner(const InterleavedHammingCoder *coder) :
+			coder_(coder) {
+	}
+
+	virtual void Run(const Code &code, const Batch &batch, Result *result) {
+		size_t depth = coder_->GetDepth();
+		size_t number_blocks = batch.number_words / depth;
+		size_t number_words = number_blocks * depth;
+		if (number_words == 0) {
+			return;
+		}
+		size_t word_length = batch.word_length;
+		size_t data_length = batch.data_length;
+		vector<Matrix::Value> data_blocks(number_words * data_length);
+		InterleavedHammingCoder::Interleave(&batch.data[0], data_length, depth,
+				number_blocks, &data_blocks[0]);
+		vector<Matrix::Value> encoded_blocks(number_words * word_length);
+		double start_time = GetTime();
+		int status = coder_->Encode(&data_blocks[0], number_blocks,
+				&encoded_blocks[0]);
+		AddTime(kEncode, start_time, result);
+		vector<Matrix::Value> words(encoded_blocks.size());
+		InterleavedHammingCoder::Deinterleave(&encoded_blocks[0], word_length,
+				depth, number_blocks, &words[0]);
+		CheckCodeWords(batch, &words[0], number_words, status, result);
+
+		InterleavedHammingCoder::Interleave(&batch.received_data[0],
+				word_length, depth, number_blocks, &encoded_blocks[0]);
+		start_time = GetTime();
+		MatrixArena arena;
+		status = coder_->Correct(&encoded_blocks[0], number_blocks, &arena);
+		AddTime(kCorrect, start_time, result);
+		InterleavedHammingCoder::Deinterleave(&encoded_blocks[0], word_length,
+				depth, number_blocks, &words[0]);
+		CheckCorrected(code, batch, &words[0], number_words, status, result);
+
+		InterleavedHammingCoder::Interleave(&batch.encoded_data[0],
+				word_length, depth, number_blocks, &encoded_blocks[0]);
+		start_time = GetTime();
+		status = coder_->Decode(&encoded_blocks[0], number_blocks,
+				&data_blocks[0]);
+		AddTime(kDecode, start_time, result);
+		vector<Matrix::Value> data(data_blocks.size());
+		InterleavedHammingCoder::Deinterleave(&data_blocks[0], data_length,
+				depth, number_blocks, &data[0]);
+		CheckDecoded(batch, &data[0], number_words, status, result);
+		result->number_words += number_words;
+	}
+
+private:
+	const InterleavedHammingCoder *coder_;
+};
+
+class BinaryRunner: public Runner {
+public:
+	explicit BinaryRunner(BinaryHammingCoder *coder) :
+			coder_(coder) {
+	}
+
+	virtual void Run(const Code &code, const Batch &batch, Result *result) {
+		size_t number_words = batch.number_words;
+		vector<PackedWord> input;
+		vector<PackedWord> output(number_words);
+		vector<Matrix::Value> symbols;
+		PackWords(&batch.data[0], number_words, batch.data_length, &input);
+		double start_time = GetTime();
+		int status = coder_->Encode(&input[0], number_words, &output[0]);
+		AddTime(kEncode, start_time, result);
+		UnpackWords(output, batch.word_length, &symbols);
+		CheckCodeWords(batch, &symbols[0], number_words, status, result);
+
+		PackWords(&batch.received_data[0], number_words, batch.word_length,
+				&input);
+		start_time = GetTime();
+		status = coder_->Correct(&input[0], number_words, &output[0]);
+		AddTime(kCorrect, start_time, result);
+		UnpackWords(output, batch.word_length, &symbols);
+		CheckCorrected(code, batch, &symbols[0], number_words, status, result);
+
+		PackWords(&batch.encoded_data[0], number_words, batch.word_length,
+				&input);
+		start_time = GetTime();
+		status = coder_->Decode(&input[0], number_words, &output[0]);
+		AddTime(kDecode, start_time, result);
+		UnpackWords(output, batch.data_length, &symbols);
+		CheckDecoded(batch, &symbols[0], number_words, status, result);
+		result->number_words += number_words;
+	}
+
+private:
+	BinaryHammingCoder *coder_;
+};
+
+class BitSlicedRunner: public Runner {
+public:
+	explicit BitSlicedRunner(BitSlicedHammingCoder *coder) :
+			coder_(coder) {
+	}
+
+	virtual void Run(const Code &code, const Batch &batch, Result *result) {
+		size_t number_words = batch.number_words;
+		size_t word_length = batch.word_length;
+		size_t data_length = batch.data_length;
+		size_t number_blocks = BitSlicedHammingCoder::GetNumberBlocks(
+				number_words);
+		size_t block_size = word_length * BitSlicedHammingCoder::kSliceLength;
+		size_t data_block_size = data_length
+				* BitSlicedHammingCoder::kSliceLength;
+		vector<PackedWord> words;
+		vector<PackedWord> data_slices(number_blocks * data_block_size);
+		vector<PackedWord> slices(number_blocks * block_size);
+		vector<PackedWord> output_slices(slices.size());
+		vector<Matrix::Value> symbols;
+		PackWords(&batch.data[0], number_words, data_length, &words);
+		BitSlicedHammingCoder::Slice(&words[0], number_words, data_length,
+				&data_slices[0]);
+		double start_time = GetTime();
+		int status = coder_->Encode(&data_slices[0], number_blocks,
+				&output_slices[0]);
+		AddTime(kEncode, start_time, result);
+		BitSlicedHammingCoder::Unslice(&output_slices[0], number_words,
+				word_length, &words[0]);
+		UnpackWords(words, word_length, &symbols);
+		CheckCodeWords(batch, &symbols[0], number_words, status, result);
+
+		PackWords(&batch.received_data[0], number_words, word_length, &words);
+		BitSlicedHammingCoder::Slice(&words[0], number_words, word_length,
+				&slices[0]);
+		start_time = GetTime();
+		status = coder_->Correct(&slices[0], number_blocks, &output_slices[0]);
+		AddTime(kCorrect, start_time, result);
+		BitSlicedHammingCoder::Unslice(&output_slices[0], number_words,
+				word_length, &words[0]);
+		UnpackWords(words, word_length, &symbols);
+		CheckCorrected(code, batch, &symbols[0], number_words, status, result);
+
+		PackWords(&batch.encoded_data[0], number_words, word_length, &words);
+		BitSlicedHammingCoder::Slice(&words[0], number_words, word_length,
+				&slices[0]);
+		start_time = GetTime();
+		status = coder_->Decode(&slices[0], number_blocks, &data_slices[0]);
+		AddTime(kDecode, start_time, result);
+		BitSlicedHammingCoder::Unslice(&data_slices[0], number_words,
+				data_length, &words[0]);
+		UnpackWords(words, data_length, &symbols);
+		CheckDecoded(batch, &symbols[0], number_words, status, result);
+		result->number_words += number_words;
+	}
+
+private:
+	BitSlicedHammingCoder *coder_;
+};
+
+// FixedHammingCoder codes one word per call.
+template<typename FixedCoder>
+class FixedRunner: public Runner {
+public:
+	virtual void Run(const Code &code, const Batch &batch, Result *result) {
+		size_t number_words = batch.number_words;
+		vector<PackedWord> input;
+		vector<PackedWord> output(number_words);
+		vector<Matrix::Value> symbols;
+		PackWords(&batch.data[0], number_words, batch.data_length, &input);
+		int status = kSuccess;
+		double start_time = GetTime();
+		for (size_t i = 0; i < number_words; ++i) {
+			status |= coder_.Encode(input[i], &output[i]);
+		}
+		AddTime(kEncode, start_time, result);
+		UnpackWords(output, batch.word_length, &symbols);
+		CheckCodeWords(batch, &symbols[0], number_words, status, result);
+
+		PackWords(&batch.received_data[0], number_words, batch.word_length,
+				&input);
+		status = kSuccess;
+		start_time = GetTime();
+		for (size_t i = 0; i < number_words; ++i) {
+			status |= coder_.Correct(input[i], &output[i]);
+		}
+		AddTime(kCorrect, start_time, result);
+		UnpackWords(output, batch.word_length, &symbols);
+		CheckCorrected(code, batch, &symbols[0], number_words, status, result);
+
+		PackWords(&batch.encoded_data[0], number_words, batch.word_length,
+				&input);
+		status = kSuccess;
+		start_time = GetTime();
+		for (size_t i = 0; i < number_words; ++i) {
+			status |= coder_.Decode(input[i], &output[i]);
+		}
+		AddTime(kDecode, start_time, result);
+		UnpackWords(output, batch.data_length, &symbols);
+		CheckDecoded(batch, &symbols[0], number_words, status, result);
+		result->number_words += number_words;
+	}
+
+private:
+	FixedCoder coder_;
+};
+
+void PrintResult(const Code &code, size_t word_length, size_t data_length,
+		const char *coder_name, const Result &result) {
+	cout << "q " << static_cast<int>(code.alphabet_size) << "\t("
+			<< word_length << "," << data_length << ")"
+			<< (code.extended ? " extended" : "") << "\t" << coder_name
+			<< "\twords " << result.number_words << "\twrong "
+			<< result.number_wrong_words << "\tmiscorrected "
+			<< result.number_miscorrected_words;
+	double data_megabytes = result.number_words * data_length / 1e6;
+	for (size_t step_i = 0; step_i < kNumberSteps; ++step_i) {
+		cout << "\t" << kStepNames[step_i] << " ";
+		if (!result.has_steps[step_i]) {
+			cout << "-";
+			continue;
+		}
+		double seconds = std::max(result.seconds[step_i], 1e-9);
+		cout << fixed << setprecision(1) << data_megabytes / seconds;
+	}
+	cout << endl;
+}
+
+// Returns the number of wrong words.
+size_t RunCoder(const Code &code, const Matrix &generator_matrix,
+		const char *coder_name, Runner *runner, const Options &options,
+		Random *random) {
+	Result result;
+	Batch batch;
+	for (size_t word_i = 0; word_i < options.number_words; word_i +=
+			kBatchLength) {
+		MakeBatch(code, generator_matrix,
+				std::min(kBatchLength, options.number_words - word_i),
+				options, random, &batch);
+		runner->Run(code, batch, &result);
+	}
+	PrintResult(code, generator_matrix.GetNumberRows(),
+			generator_matrix.GetNumberColums(), coder_name, result);
+	return result.number_wrong_words;
+}
+
+// FixedHammingCoder has its own matrices.
+template<typename FixedCoder>
+size_t RunFixedCoder(const Code &code, const Options &options,
+		Random *random) {
+	Matrix generator_matrix, checker_matrix, receiver_matrix;
+	FixedCoder::GetMatrices(&generator_matrix, &checker_matrix,
+			&receiver_matrix);
+	FixedRunner<FixedCoder> runner;
+	return RunCoder(code, generator_matrix, "fixed", &runner, options,
+			random);
+}
+
+void PrintUsage() {
+	cerr << "usage: hamming_stress [-n words] [-e error_percent]"
+			<< " [-d double_percent] [-s seed]" << endl;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+	Options options;
+	options.number_words = kDefaultNumberWords;
+	options.error_percent = kDefaultErrorPercent;
+	options.double_percent = kDefaultDoublePercent;
+	uint64_t seed = 1;
+	int option;
+	while ((option = getopt(argc, argv, "n:e:d:s:")) != -1) {
+		switch (option) {
+		case 'n':
+			options.number_words = strtoull(optarg, NULL, 10);
+			break;
+		case 'e':
+			options.error_percent = atoi(optarg);
+			break;
+		case 'd':
+			options.double_percent = atoi(optarg);
+			break;
+		case 's':
+			seed = strtoull(optarg, NULL, 10);
+			break;
+		default:
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (optind != argc || options.error_percent > 100
+			|| options.double_percent > 100) {
+		PrintUsage();
+		return 1;
+	}
+
+	const HammingCoder::Engine engines[] = { HammingCoder::kMatrixEngine,
+			HammingCoder::kTableEngine };
+	const char *engine_names[] = { "matrix", "table" };
+	Random random(seed);
+	size_t number_wrong_words = 0;
+	for (size_t code_i = 0; code_i < sizeof(kCodes) / sizeof(kCodes[0]);
+			++code_i) {
+		const Code &code = kCodes[code_i];
+		Matrix generator_matrix, checker_matrix, receiver_matrix;
+		int ret =
+				code.extended ?
+						HammingCodeFactory::CreateExtendedMatrices(
+								code.alphabet_size, code.redundancy,
+								&generator_matrix, &checker_matrix,
+								&receiver_matrix) :
+						HammingCodeFactory::CreateMatrices(code.alphabet_size,
+								code.redundancy, &generator_matrix,
+								&checker_matrix, &receiver_matrix);
+		if (ret != 0) {
+			cerr << "cannot create code " << code_i << endl;
+			return 1;
+		}
+		HammingCoder coder(code.alphabet_size, generator_matrix,
+				checker_matrix, receiver_matrix);
+		HammingCoderRunner hamming_runner(&coder, &receiver_matrix);
+		for (size_t engine_i = 0; engine_i < 2; ++engine_i) {
+			coder.SetEngine(engines[engine_i]);
+			number_wrong_words += RunCoder(code, generator_matrix,
+					engine_names[engine_i], &hamming_runner, options, &random);
+		}
+		coder.SetEngine(HammingCoder::kMatrixEngine);
+		ParallelHammingCoder parallel_coder(&coder, 0);
+		ParallelRunner parallel_runner(&parallel_coder);
+		number_wrong_words += RunCoder(code, generator_matrix, "parallel",
+				&parallel_runner, options, &random);
+		InterleavedHammingCoder interleaved_coder(&coder, kInterleavingDepth);
+		InterleavedRunner interleaved_runner(&interleaved_coder);
+		number_wrong_words += RunCoder(code, generator_matrix, "interleaved",
+				&interleaved_runner, options, &random);
+		if (code.alphabet_size != 2) {
+			continue;
+		}
+
+		BinaryHammingCoder binary_coder(generator_matrix, checker_matrix,
+				receiver_matrix);
+		BinaryRunner binary_runner(&binary_coder);
+		number_wrong_words += RunCoder(code, generator_matrix, "binary",
+				&binary_runner, options, &random);
+		BitSlicedHammingCoder bit_sliced_coder(generator_matrix,
+				checker_matrix, receiver_matrix);
+		BitSlicedRunner bit_sliced_runner(&bit_sliced_coder);
+		number_wrong_words += RunCoder(code, generator_matrix, "bitsliced",
+				&bit_sliced_runner, options, &random);
+		if (code.extended) {
+			continue;
+		}
+
+		switch (code.redundancy) {
+		case 3:
+			number_wrong_words += RunFixedCoder<hamming_code::HammingCoder7_4>(
+					code, options, &random);
+			break;
+		case 4:
+			number_wrong_words +=
+					RunFixedCoder<hamming_code::HammingCoder15_11>(code,
+							options, &random);
+			break;
+		case 5:
+			number_wrong_words +=
+					RunFixedCoder<hamming_code::HammingCoder31_26>(code,
+							options, &random);
+			break;
+		case 6:
+			number_wrong_words +=
+					RunFixedCoder<hamming_code::HammingCoder63_57>(code,
+							options, &random);
+			break;
+		}
+	}
+	return number_wrong_words == 0 ? 0 : 2;
+}